@@ -0,0 +1,56 @@
+/*
+ * OpenMPTL - C++ Microprocessor Template Library
+ *
+ * Copyright (C) 2012-2017 Axel Burri <axel@tty0.ch>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef ARM_CORTEX_COMMON_BARRIER_HPP_INCLUDED
+#define ARM_CORTEX_COMMON_BARRIER_HPP_INCLUDED
+
+#include <compiler.h>
+#include <register_type.hpp>
+
+namespace mptl {
+
+/**
+ * Memory barriers emitted by reg_access after write accesses to
+ * registers declared with a reg_barrier (see register_type.hpp).
+ *
+ * The "memory" clobber additionally keeps the compiler from moving
+ * memory accesses across the barrier.
+ */
+struct memory_barrier
+{
+  static __always_inline void dmb() { __asm volatile ("dmb" ::: "memory"); }
+  static __always_inline void dsb() { __asm volatile ("dsb" ::: "memory"); }
+  static __always_inline void isb() { __asm volatile ("isb" ::: "memory"); }
+
+  /** Emit the barrier instruction(s) for barrier (nothing for reg_barrier::none) */
+  template<reg_barrier barrier>
+  static __always_inline void after_store(void) {
+    if(barrier == reg_barrier::dmb)
+      dmb();
+    if((barrier == reg_barrier::dsb) || (barrier == reg_barrier::dsb_isb))
+      dsb();
+    if(barrier == reg_barrier::dsb_isb)
+      isb();
+  }
+};
+
+} // namespace mptl
+
+#endif // ARM_CORTEX_COMMON_BARRIER_HPP_INCLUDED
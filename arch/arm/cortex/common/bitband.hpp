@@ -23,6 +23,11 @@
 
 #include <register_type.hpp>
 
+#ifdef CONFIG_DISABLE_AUTO_BITBAND
+# define CONFIG_DISABLE_AUTO_BITBAND_WRITE
+# define CONFIG_DISABLE_AUTO_BITBAND_READ
+#endif
+
 namespace mptl {
 
 struct bitband_periph
@@ -37,6 +42,65 @@ struct bitband_periph
     return (addr >= region_start) && (addr < region_end);
   }
 
+  /*
+   * Cost model (number of Thumb-2 instructions) for writing N bits
+   * which are either all set or all cleared:
+   *
+   *   - bit-band  : mov (value 0/1), N * str
+   *   - RMW       : ldr, orr (if setting bits), bic (if clearing
+   *                 bits), str
+   *
+   * Each bit-band store is performed as a locked read-modify-write of
+   * the whole word by the bus matrix, and is thus atomic against
+   * interrupts (per bit). As any read-modify-write, it writes back
+   * the bits it did not modify: this clears flags of registers with
+   * write-to-clear bits (permission rw_wc), which are therefore never
+   * written by bit-band stores.
+   */
+  static constexpr unsigned bitop_write_cost(unsigned bitcount) {
+    return 1 + bitcount;
+  }
+  static constexpr unsigned rmw_write_cost(bool set_bits, bool clear_bits) {
+    return 2 + (set_bits ? 1 : 0) + (clear_bits ? 1 : 0);
+  }
+
+#ifdef CONFIG_DISABLE_AUTO_BITBAND_WRITE
+  static constexpr bool auto_bitop_write = false;
+#else
+  static constexpr bool auto_bitop_write = true;
+#endif
+
+#ifdef CONFIG_DISABLE_AUTO_BITBAND_READ
+  static constexpr bool auto_bitop_read = false;
+#else
+  static constexpr bool auto_bitop_read = true;
+#endif
+
+  /**
+   * Returns true if writing bitcount bits using bit-band stores is
+   * preferred over a read-modify-write, which would set (set_bits)
+   * and/or clear (clear_bits) bits. If atomic is set, bit-band stores
+   * are always preferred.
+   *
+   * CONFIG_DISABLE_AUTO_BITBAND_WRITE: use bit-band stores only if
+   * atomic is set.
+   */
+  static constexpr bool prefer_bitop_write(unsigned bitcount, bool set_bits, bool clear_bits, bool atomic) {
+    return (bitcount > 0) &&
+      (atomic || (auto_bitop_write && (bitop_write_cost(bitcount) < rmw_write_cost(set_bits, clear_bits))));
+  }
+
+  /**
+   * Returns true if reading bitcount bits using bit-band loads is
+   * preferred over a load. Only single bits are read using bit-band,
+   * as multiple bit-band loads do not result in a consistent value.
+   *
+   * CONFIG_DISABLE_AUTO_BITBAND_READ: never use bit-band loads.
+   */
+  static constexpr bool prefer_bitop_read(unsigned bitcount) {
+    return (bitcount == 1) && auto_bitop_read;
+  }
+
   template<reg_addr_t addr, unsigned bit_no>
   static __always_inline void bitset(void) {
     //    static_assert(covered(addr), "addr is not covered by the bit-band region");
@@ -60,6 +124,45 @@ struct bitband_periph
 };
 
 
+/**
+ * Bit-band access to SRAM (variables), e.g. flag words shared with
+ * interrupt handlers.
+ *
+ * Each bit-band load/store is a single instruction, atomic against
+ * interrupts (no critical section needed). The alias address is
+ * calculated at runtime, as the address of a variable is not known
+ * at compile-time (the calculation is hoisted out of loops by the
+ * compiler).
+ *
+ * NOTE: the variable must be located within the bit-band region
+ * (first 1MB of SRAM), and must be a 32bit aligned word.
+ */
+struct bitband_sram
+{
+  static constexpr reg_addr_t region_start = 0x20000000;
+  static constexpr reg_addr_t region_end   = 0x20100000;
+  static constexpr reg_addr_t alias_base   = 0x22000000;
+
+  using value_type = uint32_t;
+
+  static __always_inline volatile value_type * alias(const volatile value_type * word, unsigned bit_no) {
+    uintptr_t addr = reinterpret_cast<uintptr_t>(word);
+    return reinterpret_cast<volatile value_type *>(alias_base + ((addr - region_start) * 32) + (bit_no * 4));
+  }
+
+  static __always_inline void bitset(volatile value_type * word, unsigned bit_no) {
+    *alias(word, bit_no) = 1;
+  }
+
+  static __always_inline void bitclear(volatile value_type * word, unsigned bit_no) {
+    *alias(word, bit_no) = 0;
+  }
+
+  static __always_inline bool bittest(const volatile value_type * word, unsigned bit_no) {
+    return *alias(word, bit_no);
+  }
+};
+
 
 } // namespace mptl
 
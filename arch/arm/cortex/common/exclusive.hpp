@@ -0,0 +1,69 @@
+/*
+ * OpenMPTL - C++ Microprocessor Template Library
+ *
+ * Copyright (C) 2012-2017 Axel Burri <axel@tty0.ch>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef ARM_CORTEX_COMMON_EXCLUSIVE_HPP_INCLUDED
+#define ARM_CORTEX_COMMON_EXCLUSIVE_HPP_INCLUDED
+
+#include <cstdint>
+#include <compiler.h>
+
+namespace mptl {
+
+/**
+ * Exclusive load/store (LDREX/STREX), used for atomic
+ * read-modify-write of registers (see reg_access::atomic_set()).
+ *
+ * NOTE: The local exclusive monitor is cleared on exception entry
+ * and return, making store() fail if an interrupt occurred between
+ * load() and store().
+ */
+struct exclusive_access
+{
+  template<typename T>
+  static __always_inline T load(volatile T * addr) {
+    static_assert(sizeof(T) <= 4, "exclusive access is limited to 32bit");
+    uint32_t value;
+    if(sizeof(T) == 1)
+      __asm volatile ("ldrexb %0, [%1]" : "=r" (value) : "r" (addr) : "memory");
+    else if(sizeof(T) == 2)
+      __asm volatile ("ldrexh %0, [%1]" : "=r" (value) : "r" (addr) : "memory");
+    else
+      __asm volatile ("ldrex %0, [%1]"  : "=r" (value) : "r" (addr) : "memory");
+    return static_cast<T>(value);
+  }
+
+  /** Returns true if the exclusive store succeeded. */
+  template<typename T>
+  static __always_inline bool store(volatile T * addr, T const value) {
+    static_assert(sizeof(T) <= 4, "exclusive access is limited to 32bit");
+    uint32_t result;
+    if(sizeof(T) == 1)
+      __asm volatile ("strexb %0, %2, [%1]" : "=&r" (result) : "r" (addr), "r" (static_cast<uint32_t>(value)) : "memory");
+    else if(sizeof(T) == 2)
+      __asm volatile ("strexh %0, %2, [%1]" : "=&r" (result) : "r" (addr), "r" (static_cast<uint32_t>(value)) : "memory");
+    else
+      __asm volatile ("strex %0, %2, [%1]"  : "=&r" (result) : "r" (addr), "r" (static_cast<uint32_t>(value)) : "memory");
+    return result == 0;
+  }
+};
+
+} // namespace mptl
+
+#endif // ARM_CORTEX_COMMON_EXCLUSIVE_HPP_INCLUDED
@@ -37,6 +37,24 @@ struct irq_base {
 };
 
 
+/**
+ * Conversion between priority level and priority byte (as stored in
+ * NVIC::IPR or SCB::SHPR), for devices implementing the upper
+ * priority_bits of the byte (e.g. 4 on STM32).
+ */
+template<unsigned priority_bits>
+struct priority_level {
+  static_assert(priority_bits > 0 && priority_bits <= 8, "illegal priority_bits");
+
+  static constexpr uint8_t shifted(uint8_t level) {
+    return static_cast<uint8_t>(level << (8 - priority_bits));
+  }
+  static constexpr uint8_t unshifted(uint8_t priority) {
+    return static_cast<uint8_t>(priority >> (8 - priority_bits));
+  }
+};
+
+
 ////////////////////  core_exception  ////////////////////
 
 
@@ -44,19 +62,39 @@ template<int irqn>
 class core_exception : public irq_base<irqn> {
   static_assert(irqn < 0 && irqn > -16, "illegal core exception interrupt number");
 
-#if 0
 public:
 
   static constexpr bool priority_available = irqn > -13;
 
-  static typename std::enable_if<priority_available>::type set_priority(uint32_t priority) {
-    scb::set_priority<irqn>(priority);
+  /**
+   * Set raw priority byte of the exception (NOT the priority level,
+   * see set_priority_level()). Only the upper priority bits are
+   * implemented. Performed by a single byte store
+   * to SCB::SHPR (see reg_lane).
+   */
+  static void set_priority(uint8_t priority) {
+    static_assert(priority_available, "priority of core exception is fixed");
+    SCB::SHPRx< irqn + 16 >::set_from(priority);
+  }
+
+  static uint8_t get_priority(void) {
+    static_assert(priority_available, "priority of core exception is fixed");
+    return SCB::SHPRx< irqn + 16 >::load_and_shift();
   }
 
-  static typename std::enable_if<priority_available, uint32_t>::type get_priority(void) {
-    return scb::set_priority<irqn>();
+  /**
+   * Set priority level (0 .. 2^priority_bits - 1), shifted to the
+   * implemented upper bits of the priority byte.
+   */
+  template<unsigned priority_bits>
+  static void set_priority_level(uint8_t level) {
+    set_priority(priority_level<priority_bits>::shifted(level));
+  }
+
+  template<unsigned priority_bits>
+  static uint8_t get_priority_level(void) {
+    return priority_level<priority_bits>::unshifted(get_priority());
   }
-#endif
 };
 
 
@@ -75,7 +113,7 @@ class irq_channel : public irq_base<irqn> {
   using ISPRx = NVIC::ISPR<reg_index>;
   using ICPRx = NVIC::ICPR<reg_index>;
   using IABRx = NVIC::IABR<reg_index>;
-  using IPRx  = NVIC::IPR<irqn>;
+  using IPRx  = NVIC::IPRx<irqn>;
 
 public:
 
@@ -100,15 +138,83 @@ public:
     return IABRx::load() & (irq_bit);
   }
 
-#if 0
-  static void set_priority(uint32_t priority) {
-    IPRx::store((priority << (8 - priority_bits)) & 0xff);
+  /**
+   * Set raw priority byte of the interrupt (NOT the priority level,
+   * see set_priority_level()). Only the upper priority bits are
+   * implemented. Performed by a single byte store
+   * to NVIC::IPR (see reg_lane).
+   */
+  static void set_priority(uint8_t priority) {
+    IPRx::set_from(priority);
+  }
+
+  static uint8_t get_priority(void) {
+    return IPRx::load_and_shift();
+  }
+
+  /**
+   * Set priority level (0 .. 2^priority_bits - 1), shifted to the
+   * implemented upper bits of the priority byte.
+   */
+  template<unsigned priority_bits>
+  static void set_priority_level(uint8_t level) {
+    set_priority(priority_level<priority_bits>::shifted(level));
+  }
+
+  template<unsigned priority_bits>
+  static uint8_t get_priority_level(void) {
+    return priority_level<priority_bits>::unshifted(get_priority());
+  }
+};
+
+
+////////////////////  irq_channel_runtime  ////////////////////
+
+
+/**
+ * Interrupt channel control for interrupt numbers known at runtime
+ * only (e.g. from a table), using runtime-indexed NVIC registers
+ * (see reg_array). Use irq_channel<> if irqn is known at
+ * compile-time.
+ */
+class irq_channel_runtime {
+  static constexpr std::size_t reg_count = 8;
+
+  using ISER = reg_array< NVIC::ISER<0>, 4, reg_count >;
+  using ICER = reg_array< NVIC::ICER<0>, 4, reg_count >;
+  using ISPR = reg_array< NVIC::ISPR<0>, 4, reg_count >;
+  using ICPR = reg_array< NVIC::ICPR<0>, 4, reg_count >;
+  using IABR = reg_array< NVIC::IABR<0>, 4, reg_count >;
+
+  static constexpr std::size_t reg_index(unsigned irqn) {
+    return irqn >> 5;
+  }
+  static constexpr uint32_t irq_bit(unsigned irqn) {
+    return 1u << (irqn & 0x1F);
+  }
+
+public:
+
+  static void enable(unsigned irqn) {
+    ISER::store(reg_index(irqn), irq_bit(irqn));
+  }
+  static void disable(unsigned irqn) {
+    ICER::store(reg_index(irqn), irq_bit(irqn));
   }
 
-  static uint32_t get_priority(void) {
-    return((uint32_t)(IPRx::load() >> (8 - priority_bits)));
+  static bool is_pending(unsigned irqn) {
+    return ISPR::load(reg_index(irqn)) & irq_bit(irqn);
+  }
+  static void set_pending(unsigned irqn) {
+    ISPR::store(reg_index(irqn), irq_bit(irqn));
+  }
+
+  static void clear_pending(unsigned irqn) {
+    ICPR::store(reg_index(irqn), irq_bit(irqn));
+  }
+  static bool is_active(unsigned irqn) {
+    return IABR::load(reg_index(irqn)) & irq_bit(irqn);
   }
-#endif
 };
 
 
@@ -34,7 +34,7 @@ namespace mptl {
 struct MPU
 {
   using TYPE     = reg< uint32_t, 0xE000ED90, ro, 0x00000800 >;  /**< MPU Type Register                        */
-  using CTRL     = reg< uint32_t, 0xE000ED94, rw             >;  /**< MPU Control Register                     */
+  using CTRL     = reg< uint32_t, 0xE000ED94, rw, 0, reg_barrier::dsb_isb >;  /**< MPU Control Register  */
   using RNR      = reg< uint32_t, 0xE000ED98, rw             >;  /**< MPU Region Number Register               */
   using RBAR     = reg< uint32_t, 0xE000ED9C, rw             >;  /**< MPU Region Base Address Register         */
   using RASR     = reg< uint32_t, 0xE000EDA0, rw             >;  /**< MPU Region Attribute and Size Register   */
@@ -22,6 +22,7 @@
 #define ARM_CORTEX_COMMON_REG_NVIC_HPP_INCLUDED
 
 #include <register.hpp>
+#include <register_array.hpp>
 
 namespace mptl {
 
@@ -44,9 +45,9 @@ struct NVIC
   class ISER : public reg<uint32_t, 0xE000E100 + 4 * reg_index, rw >
   { static_assert(reg_index < 8, "invalid index for register"); };
 
-  /** Interrupt Set-Enable Registers */
+  /** Interrupt Clear-Enable Registers (barrier: interrupt is disabled after the write) */
   template<unsigned reg_index>
-  class ICER : public reg<uint32_t, 0xE000E180 + 4 * reg_index, rw >
+  class ICER : public reg<uint32_t, 0xE000E180 + 4 * reg_index, rw, 0, reg_barrier::dsb_isb >
   { static_assert(reg_index < 8, "invalid index for register"); };
 
   /** Interrupt Set-Pending Registers */
@@ -64,10 +65,14 @@ struct NVIC
   class IABR : public reg<uint32_t, 0xE000E300 + 4 * reg_index, ro >
   { static_assert(reg_index < 8, "invalid index for register"); };
 
-  /** Interrupt Priority Register */
+  /** Interrupt Priority Register (byte-accessible) */
   template<unsigned reg_index>
-  class IPR  : public reg<uint32_t, 0xE000E400 + 4 * reg_index, rw >
+  class IPR  : public reg<uint32_t, 0xE000E400 + 4 * reg_index, rw, 0, reg_barrier::none, reg_lane::byte >
   { static_assert(reg_index < 60, "invalid index for register"); };
+
+  /** Priority field of interrupt irqn (written by a single byte store) */
+  template<unsigned irqn>
+  using IPRx = regbits< typename IPR< irqn / 4 >::type, (irqn % 4) * 8, 8 >;
 };
 
 } // namespace mptl
@@ -109,9 +109,12 @@ struct SCB
 
   /**
    * Vector Table Offset Register
+   *
+   * Barrier: the new vector table is used for exceptions taken
+   * right after the write.
    */
   struct VTOR
-  : public reg< uint32_t, 0xE000ED08, rw >
+  : public reg< uint32_t, 0xE000ED08, rw, 0, reg_barrier::dsb_isb >
   {
     using TBLOFF   = regbits< type,  7, 22 >;  /**< [28: 7] Vector table base offset field    */
     using TBLBASE  = regbits< type, 29,  1 >;  /**< [29:29] Table base in code(0) or RAM(1)   */
@@ -121,7 +124,7 @@ struct SCB
    * Application Interrupt and Reset Control Register
    */
   struct AIRCR
-  : public reg< uint32_t, 0xE000ED0C, rw >
+  : public reg< uint32_t, 0xE000ED0C, rw, 0, reg_barrier::dsb >
   {
     using VECTRESET      = regbits< type,  0,  1 >;  /**< [ 0: 0] System Reset bit                                         */
     using VECTCLRACTIVE  = regbits< type,  1,  1 >;  /**< [ 1: 1] Clear active vector bit                                  */
@@ -135,7 +138,7 @@ struct SCB
    * System Control Register
    */
   struct SCR
-  : public reg< uint32_t, 0xE000ED10, rw >
+  : public reg< uint32_t, 0xE000ED10, rw, 0, reg_barrier::dsb >
   {
     using SLEEPONEXIT  = regbits< type,  1,  1 >;  /**< [ 1: 1] Sleep on exit bit   */
     using SLEEPDEEP    = regbits< type,  2,  1 >;  /**< [ 2: 2] Sleep deep bit      */
@@ -146,7 +149,7 @@ struct SCB
    * Configuration and Control Register
    */
   struct CCR
-  : public reg< uint32_t, 0xE000ED14, rw, 0x00000200 >
+  : public reg< uint32_t, 0xE000ED14, rw, 0x00000200, reg_barrier::dsb_isb >
   {
     using NONBASETHRDENA  = regbits< type,  0,  1 >;  /**< [ 0: 0] Thread mode can be entered from any level in Handler mode by controlled return value                    */
     using USERSETMPEND    = regbits< type,  1,  1 >;  /**< [ 1: 1] Enables user code to write the Software Trigger Interrupt register to trigger (pend) a Main exception   */
@@ -157,15 +160,15 @@ struct SCB
   };
 
   /**
-   * System Handler Priority Register
+   * System Handler Priority Register (byte-accessible)
    */
   template<unsigned reg_index>
   struct SHPR
-  : public reg< uint32_t, 0xE000ED18 + 4 * reg_index, rw >
+  : public reg< uint32_t, 0xE000ED18 + 4 * reg_index, rw, 0, reg_barrier::none, reg_lane::byte >
   {
     static_assert(reg_index < 3, "invalid index for register");
 
-    using type = reg< uint32_t, 0xE000ED18 + 4 * reg_index, rw >;
+    using type = reg< uint32_t, 0xE000ED18 + 4 * reg_index, rw, 0, reg_barrier::none, reg_lane::byte >;
 
     // TODO: template PRIx
     using PRI_N   = regbits< type,  0,  8 >;  /**< [ 7: 0] Priority of system handler 4,8, and 12. Mem Manage, reserved and Debug Monitor   */
@@ -174,6 +177,10 @@ struct SCB
     using PRI_N3  = regbits< type, 24,  8 >;  /**< [31:24] Priority of system handler 7,11, and 15. Reserved, SVCall and SysTick            */
   };
 
+  /** Priority field of system handler handler_no (4..15, written by a single byte store) */
+  template<unsigned handler_no>
+  using SHPRx = regbits< typename SHPR< (handler_no - 4) / 4 >::type, (handler_no % 4) * 8, 8 >;
+
   /**
    * System Handler Control and State Register
    */
@@ -94,49 +94,52 @@ namespace mpl
   };
 #endif
 
-  /** recursively build the vector table  */
-  template< unsigned int N,
-            int          irqn_offset,
-            typename     irq_handler_list,
-            isr_t        default_isr,
-            const        uint32_t *stack_top,
-            typename...  Tp >
-  struct make_vector_table
+  /**
+   * Build the vector table in a single pack expansion over the vector
+   * indices (I = irqn - irqn_offset), looking up the irq handlers in
+   * a precomputed irqn->handler map (see irq_handler_lookup).
+   */
+  template< typename         index_sequence_type,
+            int              irqn_offset,
+            typename         irq_handler_list,
+            isr_t            default_isr,
+            const uint32_t * stack_top >
+  struct make_vector_table_impl;
+
+  template< std::size_t...   I,
+            int              irqn_offset,
+            typename         irq_handler_list,
+            isr_t            default_isr,
+            const uint32_t * stack_top >
+  struct make_vector_table_impl< index_sequence< I... >, irqn_offset, irq_handler_list, default_isr, stack_top >
   {
-    static constexpr int irqn = (N - 1) + irqn_offset;
-    using irq_handler_resource = mpl::unique_irq_handler<irq_handler_list, irqn>;
-    using irq_handler_default = irq_handler< irq_base< irqn >, default_isr >;
+    using lookup = irq_handler_lookup< mpl::irq_handler_list< irq_handler_list > >;
 
     /** irq_handler<> from irq_handler<irqn> in irq_handler_list if
      *  present, default_isr if not. default_isr if irqn is a
      *  reserved_irqn() */
+    template< int irqn, typename irq_handler_resource = typename lookup::template handler< irqn > >
     using irq_handler_type = typename std::conditional<
       ( irq::reserved_irqn(irqn) ||
         std::is_void< irq_handler_resource >::value ),
-      irq_handler_default,
+      irq_handler< irq_base< irqn >, default_isr >,
       irq_handler_resource >::type;
 
-    /** recursion */
-    using type = typename make_vector_table<
-      N - 1,
-      irqn_offset,
-      irq_handler_list,
-      default_isr,
+    using type = vector_table_impl<
       stack_top,
-      irq_handler_type,
-      Tp...
-      >::type;
+      irq_handler_type< static_cast<int>(I) + irqn_offset >...
+      >;
   };
 
-  /* last irq number (N) is irq::reset::irqn */
-  template< int              irqn_offset,
+  /* first irq number is irq::reset::irqn (irqn_offset) */
+  template< unsigned int     N,
+            int              irqn_offset,
             typename         irq_handler_list,
             isr_t            default_isr,
-            const uint32_t * stack_top,
-            typename...      Tp >
-  struct make_vector_table< 0, irqn_offset, irq_handler_list, default_isr, stack_top, Tp... > {
-    using type = vector_table_impl<stack_top, Tp...>;
-  };
+            const uint32_t * stack_top >
+  struct make_vector_table
+  : make_vector_table_impl< make_index_sequence< N >, irqn_offset, irq_handler_list, default_isr, stack_top >
+  { };
 } // namespace mpl
 
 
@@ -168,7 +171,7 @@ namespace mpl
 template<const uint32_t *stack_top, typename irq_handler_list, isr_t default_isr = nullptr >
 struct vector_table
 : mpl::make_vector_table<
-  irq::numof_interrupt_channels - irq::reset::irqn,  /* start index */
+  irq::numof_interrupt_channels - irq::reset::irqn,  /* number of vectors */
   irq::reset::irqn,  /* irqn_offset (negative) */
   irq_handler_list,
   default_isr,
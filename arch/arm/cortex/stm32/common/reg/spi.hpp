@@ -115,9 +115,9 @@ struct SPI_Common
    * Status register
    */
   struct SR
-  : public reg< std::uint_fast16_t, base_addr + 0x08, rw, 0x0002 >
+  : public reg< std::uint_fast16_t, base_addr + 0x08, rw_wc, 0x0002 >
   {
-    using type = reg< std::uint_fast16_t, base_addr + 0x8, rw, 0x0002 >;
+    using type = reg< std::uint_fast16_t, base_addr + 0x8, rw_wc, 0x0002 >;
 
     using BSY     = regbits< type,  7,  1 >;  /**< Busy flag                 */
     using OVR     = regbits< type,  6,  1 >;  /**< Overrun flag              */
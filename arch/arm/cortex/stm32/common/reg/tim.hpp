@@ -138,9 +138,9 @@ struct TIM_common
    * Status register
    */
   struct SR
-  : public reg< std::uint_fast16_t, base_addr + 0x10, rw, 0x0000 >
+  : public reg< std::uint_fast16_t, base_addr + 0x10, rw_wc, 0x0000 >
   {
-    using type = reg< std::uint_fast16_t, base_addr + 0x10, rw, 0x0000 >;
+    using type = reg< std::uint_fast16_t, base_addr + 0x10, rw_wc, 0x0000 >;
 
     using CC4OF  = regbits< type, 12,  1 >;  /**< Capture/Compare 4 overcapture flag  */
     using CC3OF  = regbits< type, 11,  1 >;  /**< Capture/Compare 3 overcapture flag  */
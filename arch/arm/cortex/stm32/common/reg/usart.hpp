@@ -52,7 +52,7 @@ struct USART_common
    * Status register
    */
   struct SR
-  : public reg< std::uint_fast16_t, base_addr + 0x00, rw, 0x00c0 >
+  : public reg< std::uint_fast16_t, base_addr + 0x00, rw_wc, 0x00c0 >
   {
     // TODO: document why it sucks to have to define a typedef "type"
     // here again.  This is required here (by the standard) because
@@ -77,7 +77,7 @@ struct USART_common
     // 
     // see discussion here: http://stackoverflow.com/questions/1643035/propagating-typedef-from-based-to-derived-class-for-template
     //
-    using type = reg< std::uint_fast16_t, base_addr + 0x00, rw, 0x00c0 >;
+    using type = reg< std::uint_fast16_t, base_addr + 0x00, rw_wc, 0x00c0 >;
 
     using CTS   = regbits< type,  9,  1 >;   /**< CTS flag                      */
     using LBD   = regbits< type,  8,  1 >;   /**< LIN break detection flag      */
@@ -104,11 +104,15 @@ struct USART_common
 
   /**
    * Baud rate register
+   *
+   * NOTE: accessed as half-word (bits 16-31 are reserved), which
+   * makes a merged DIV_Mantissa/DIV_Fraction regmask cover the whole
+   * register, resulting in a single store() on set().
    */
   struct BRR
-  : public reg< std::uint_fast16_t, base_addr + 0x08, rw, 0x0000 >
+  : public reg< std::uint16_t, base_addr + 0x08, rw_sw, 0x0000 >
   {
-    using type = reg< std::uint_fast16_t, base_addr + 0x08, rw, 0x0000 >;
+    using type = reg< std::uint16_t, base_addr + 0x08, rw_sw, 0x0000 >;
 
     using DIV_Mantissa = regbits< type,  4, 12 >;   /**< mantissa of USARTDIV  */
     using DIV_Fraction = regbits< type,  0,  4 >;   /**< fraction of USARTDIV  */
@@ -142,9 +146,9 @@ struct USART_common
    * Control register 2
    */
   struct CR2
-  : public reg< std::uint_fast16_t, base_addr + 0x10, rw, 0x0000 >
+  : public reg< std::uint_fast16_t, base_addr + 0x10, rw_sw, 0x0000 >
   {
-    using type = reg< std::uint_fast16_t, base_addr + 0x10, rw, 0x0000 >;
+    using type = reg< std::uint_fast16_t, base_addr + 0x10, rw_sw, 0x0000 >;
 
     using LINEN  = regbits< type, 14,  1 >;   /**< LIN mode enable                       */
     using STOP   = regbits< type, 12,  2 >;   /**< STOP bits                             */
@@ -161,9 +165,9 @@ struct USART_common
    * Control register 3
    */
   struct CR3
-  : public reg< std::uint_fast16_t, base_addr + 0x14, rw, 0x0000 >
+  : public reg< std::uint_fast16_t, base_addr + 0x14, rw_sw, 0x0000 >
   {
-    using type = reg< std::uint_fast16_t, base_addr + 0x14, rw, 0x0000 >;
+    using type = reg< std::uint_fast16_t, base_addr + 0x14, rw_sw, 0x0000 >;
 
     using CTSIE  = regbits< type, 10,  1 >;   /**< CTS interrupt enable    */
     using CTSE   = regbits< type,  9,  1 >;   /**< CTS enable              */
@@ -0,0 +1,81 @@
+/*
+ * OpenMPTL - C++ Microprocessor Template Library
+ *
+ * Copyright (C) 2012-2017 Axel Burri <axel@tty0.ch>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef ARM_CORTEX_STM32_COMMON_REG_ORDER_HPP_INCLUDED
+#define ARM_CORTEX_STM32_COMMON_REG_ORDER_HPP_INCLUDED
+
+#include <register_type.hpp>
+#include <arch/reg_set_reset.hpp>
+
+namespace mptl {
+
+/**
+ * Register write order, used by reglist<> to sort its registers
+ * before emitting the register accesses (e.g. reglist<>::reset_to()).
+ *
+ * Each register is assigned an ordering key (rank()) by its address.
+ * Registers are written by ascending rank, and by ascending address
+ * within the same rank:
+ *
+ *   0. reset and clock control (RCC): writes to a peripheral register
+ *      are ignored as long as the peripheral clock is not enabled.
+ *
+ *   1. power control (PWR): the backup domain (RTC, BKP registers) is
+ *      write protected until PWR_CR.DBP is set.
+ *
+ *   2. GPIO output data registers (GPIOx::ODR): the output levels are
+ *      set before the port configuration registers switch the pins to
+ *      output mode, avoiding glitches on the pins.
+ *
+ *   3. all other registers.
+ *
+ * NOTE: This only covers the dependencies listed above. Other
+ * hardware dependencies (e.g. FLASH_ACR latency before switching the
+ * system clock, enable bits which must be written after the
+ * remaining configuration of a peripheral, or bits which need a
+ * specific write sequence) are not known here: use separate
+ * reglist<> for these, applied in the required order.
+ */
+template< reg_addr_t rcc_base_addr, reg_addr_t pwr_base_addr >
+struct reg_order_stm32_common
+{
+  static constexpr reg_addr_t region_size = 0x400;
+
+  static constexpr bool region(reg_addr_t addr, reg_addr_t base_addr) {
+    return (addr >= base_addr) && (addr < base_addr + region_size);
+  }
+
+  /** Ordering key of the register at addr (see above) */
+  static constexpr unsigned rank(reg_addr_t addr) {
+    return region(addr, rcc_base_addr) ? 0 :
+      region(addr, pwr_base_addr)      ? 1 :
+      reg_set_reset::output(addr)      ? 2 :
+      3;
+  }
+
+  /** True if register at addr_a is written before register at addr_b */
+  static constexpr bool less(reg_addr_t addr_a, reg_addr_t addr_b) {
+    return (rank(addr_a) != rank(addr_b)) ? (rank(addr_a) < rank(addr_b)) : (addr_a < addr_b);
+  }
+};
+
+} // namespace mptl
+
+#endif // ARM_CORTEX_STM32_COMMON_REG_ORDER_HPP_INCLUDED
@@ -0,0 +1,91 @@
+/*
+ * OpenMPTL - C++ Microprocessor Template Library
+ *
+ * Copyright (C) 2012-2017 Axel Burri <axel@tty0.ch>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef ARM_CORTEX_STM32_COMMON_REG_SET_RESET_HPP_INCLUDED
+#define ARM_CORTEX_STM32_COMMON_REG_SET_RESET_HPP_INCLUDED
+
+#include <register_type.hpp>
+
+namespace mptl {
+
+/**
+ * Output registers with an associated set/reset register, used by
+ * regmask<>::set() and regmask<>::clear() to lower read-modify-write
+ * sequences into a single (atomic) store.
+ *
+ * The GPIO port output data registers (GPIOx::ODR) are set/reset by
+ * storing to GPIOx::BSRR: the low half (width bits) sets, the high
+ * half resets the corresponding ODR bits.
+ */
+template<
+  template<char> class gpio,   /* GPIO<port> register declarations (arch/reg/gpio.hpp) */
+  reg_addr_t gpio_base_addr,   /* GPIOA base address */
+  unsigned   port_count,       /* number of GPIO ports */
+  reg_addr_t odr_offset,       /* ODR offset from GPIO base address */
+  reg_addr_t bsrr_offset       /* BSRR offset from GPIO base address */
+  >
+struct reg_set_reset_stm32_common
+{
+  static constexpr reg_addr_t gpio_stride      = 0x400;
+  static constexpr reg_addr_t gpio_region_end  = gpio_base_addr + port_count * gpio_stride;
+
+  /** Number of output bits covered by the set/reset register */
+  static constexpr unsigned width = 16;
+
+  /** Lane access of the set/reset register (as declared in GPIOx::BSRR) */
+  static constexpr reg_lane lane = reg_lane::halfword;
+
+  static constexpr bool gpio_offset(reg_addr_t addr, reg_addr_t offset) {
+    return (addr >= gpio_base_addr) && (addr < gpio_region_end) &&
+      ((addr - gpio_base_addr) % gpio_stride == offset);
+  }
+
+  /** True if the register at addr is an output register (GPIOx::ODR) */
+  static constexpr bool output(reg_addr_t addr) {
+    return gpio_offset(addr, odr_offset);
+  }
+
+  /** True if the register at addr is a set/reset register (GPIOx::BSRR) */
+  static constexpr bool set_reset(reg_addr_t addr) {
+    return gpio_offset(addr, bsrr_offset);
+  }
+
+  /** Address of the set/reset register of the output register at addr */
+  static constexpr reg_addr_t set_reset_addr(reg_addr_t output_addr) {
+    return output_addr - odr_offset + bsrr_offset;
+  }
+
+  /** Address of the output register of the set/reset register at addr */
+  static constexpr reg_addr_t output_addr(reg_addr_t set_reset_addr) {
+    return set_reset_addr - bsrr_offset + odr_offset;
+  }
+
+  /**
+   * reg<> type of the output register at addr (GPIOx::ODR), as
+   * declared in arch/reg/gpio.hpp. Used by the simulation to apply
+   * set/reset stores to the register state of GPIOx::ODR.
+   */
+  template<reg_addr_t addr>
+  using output_type = typename gpio< static_cast<char>('A' + (addr - gpio_base_addr) / gpio_stride) >::ODR;
+};
+
+} // namespace mptl
+
+#endif // ARM_CORTEX_STM32_COMMON_REG_SET_RESET_HPP_INCLUDED
@@ -24,6 +24,7 @@
 #include <arch/rcc.hpp>
 #include <arch/nvic.hpp>
 #include <arch/reg/spi.hpp>
+#include <register_wait.hpp>
 #include <type_traits>
 
 namespace mptl {
@@ -125,27 +126,70 @@ public:  /* ------ configuration traits ------ */
 public:  /* ------ static member functions ------ */
 
   /**
-   * Configure SPI register using Tp type traits.
+   * Configure SPI register using Tp type traits, using given write strategy
+   * (see write_strategy in register_type.hpp). Registers not covered
+   * by Tp are only reset for write_strategy::reset_to.
    *
    * NOTE: make sure no communication is ongoing when calling this function.
    */
-  template< typename... Tp >
+  template< write_strategy strategy, typename... Tp >
   static void configure(void) {
-    reglist< Tp... >::template strict_reset_to<
+    reglist< Tp... >::template strict_apply< strategy,
       typename SPIx::CR1
       >();
   }
 
+  /**
+   * Configure SPI register using Tp type traits.
+   *
+   * NOTE: make sure no communication is ongoing when calling this function.
+   */
+  template< typename... Tp >
+  static void configure(void) {
+    configure< write_strategy::reset_to, Tp... >();
+  }
+
   /**
    * Disable SPI, configure SPI register using Tp type traits, and enable SPI.
    *
    * NOTE: make sure no communication is ongoing when calling this function.
    */
   template< typename... Tp >
+  static void reconfigure(void) {
+    reconfigure< write_strategy::reset_to, Tp... >();
+  }
+
+  /**
+   * Disable SPI, configure SPI register using Tp type traits (using
+   * given write strategy), and enable SPI.
+   *
+   * NOTE: make sure no communication is ongoing when calling this function.
+   */
+  template< write_strategy strategy, typename... Tp >
   static void reconfigure(void) {
     disable();
     /* configure and enable SPI in one register write */
-    configure< typename SPIx::CR1::SPE, Tp... >();
+    configure< strategy, typename SPIx::CR1::SPE, Tp... >();
+  }
+
+  /**
+   * Switch from SPI configuration From to configuration To (both
+   * lists of type traits, as passed to reconfigure<>()), writing only
+   * if the register values differ (see reglist_transition).
+   *
+   * Unlike reconfigure<>(), SPI is not disabled in between.
+   *
+   * NOTE: make sure no communication is ongoing when calling this function.
+   * NOTE: From must be the configuration currently set.
+   */
+  template< typename From, typename To >
+  static void transition(void) {
+    reglist_transition<
+      reglist< typename SPIx::CR1::SPE, From >,
+      reglist< typename SPIx::CR1::SPE, To >
+      >::template strict_apply< write_strategy::reset_to,
+        typename SPIx::CR1
+      >();
   }
 
   static void reset_crc(void) {
@@ -159,14 +203,14 @@ public:  /* ------ static member functions ------ */
     SPIx::CR1::SPE::clear();
   }
 
-  static void wait_transmit_empty(void) {
-    while(SPIx::SR::TXE::test() == false);
+  static wait_result wait_transmit_empty(wait_timeout const timeout = wait_timeout::forever()) {
+    return wait_until< typename SPIx::SR::TXE >(timeout);
   }
-  static void wait_receive_not_empty(void) {
-    while(SPIx::SR::RXNE::test() == false);
+  static wait_result wait_receive_not_empty(wait_timeout const timeout = wait_timeout::forever()) {
+    return wait_until< typename SPIx::SR::RXNE >(timeout);
   }
-  static void wait_not_busy(void) {
-    while(SPIx::SR::BSY::test());
+  static wait_result wait_not_busy(wait_timeout const timeout = wait_timeout::forever()) {
+    return wait_while< typename SPIx::SR::BSY >(timeout);
   }
 
   static void send(uint16_t data) {
@@ -24,6 +24,7 @@
 #include <arch/nvic.hpp>
 #include <arch/rcc.hpp>
 #include <arch/reg/usart.hpp>
+#include <register_manip.hpp>
 #include <type_traits>
 
 namespace mptl {
@@ -83,6 +84,17 @@ private:
       >;
   };
 
+  using cr1_value_type = typename USARTx::CR1::value_type;
+
+  /* CR1 interrupt enable bits */
+  static cr1_value_type interrupt_mask(bool rxne, bool txe, bool pe, bool tc, bool idle) {
+    return ((rxne ? USARTx::CR1::RXNEIE::clear_mask : 0) |
+            (txe  ? USARTx::CR1::TXEIE::clear_mask  : 0) |
+            (pe   ? USARTx::CR1::PEIE::clear_mask   : 0) |
+            (tc   ? USARTx::CR1::TCIE::clear_mask   : 0) |
+            (idle ? USARTx::CR1::IDLEIE::clear_mask : 0));
+  }
+
 public:  /* ------ configuration traits ------ */
 
   using enable_rx = regval< typename USARTx::CR1::RE, 1 >;
@@ -149,13 +161,15 @@ public:  /* ------ configuration traits ------ */
 public:  /* ------ static member functions ------ */
 
   /**
-   * Configure USART register using Tp type traits.
+   * Configure USART register using Tp type traits, using given write strategy
+   * (see write_strategy in register_type.hpp). Registers not covered
+   * by Tp are only reset for write_strategy::reset_to.
    *
    * NOTE: make sure no communication is ongoing when calling this function.
    */
-  template< typename... Tp >
+  template< write_strategy strategy, typename... Tp >
   static void configure(void) {
-    reglist< Tp... >::template strict_reset_to<
+    reglist< Tp... >::template strict_apply< strategy,
       typename USARTx::CR1,
       typename USARTx::CR2,
       typename USARTx::CR3,
@@ -163,6 +177,16 @@ public:  /* ------ static member functions ------ */
       >();
   }
 
+  /**
+   * Configure USART register using Tp type traits.
+   *
+   * NOTE: make sure no communication is ongoing when calling this function.
+   */
+  template< typename... Tp >
+  static void configure(void) {
+    configure< write_strategy::reset_to, Tp... >();
+  }
+
   /**
    * Set the BRR register to the value corresponding to the baud_rate
    * provided.
@@ -192,19 +216,17 @@ public:  /* ------ static member functions ------ */
     USARTx::CR1::UE::clear();
   }
 
+  /*
+   * NOTE: CR1 is also modified by the ISR (see enable_tx_interrupt()),
+   * the interrupt enable bits are thus written using atomic access.
+   */
   static void enable_interrupt(bool rxne,           /**< read data register not empty interrupt    */
                                bool txe  = false,   /**< transmitter data register empty interrupt */
                                bool pe   = false,   /**< parity error interrupt                    */
                                bool tc   = false,   /**< transmission complete interrupt           */
                                bool idle = false)   /**< idle interrupt                            */
   {
-    auto cr1 = USARTx::CR1::load();
-    if(rxne) cr1 |= USARTx::CR1::RXNEIE::value;
-    if(txe)  cr1 |= USARTx::CR1::TXEIE::value;
-    if(pe)   cr1 |= USARTx::CR1::PEIE::value;
-    if(tc)   cr1 |= USARTx::CR1::TCIE::value;
-    if(idle) cr1 |= USARTx::CR1::IDLEIE::value;
-    USARTx::CR1::store(cr1);
+    USARTx::CR1::atomic_set(interrupt_mask(rxne, txe, pe, tc, idle), 0);
   }
 
   static void disable_interrupt(bool rxne,          /**< read data register not empty interrupt    */
@@ -213,17 +235,12 @@ public:  /* ------ static member functions ------ */
                                 bool tc   = false,  /**< transmission complete interrupt           */
                                 bool idle = false)  /**< idle interrupt                            */
   {
-    auto cr1 = USARTx::CR1::load();
-    if(rxne) cr1 &= ~USARTx::CR1::RXNEIE::value;
-    if(txe)  cr1 &= ~USARTx::CR1::TXEIE::value;
-    if(pe)   cr1 &= ~USARTx::CR1::PEIE::value;
-    if(tc)   cr1 &= ~USARTx::CR1::TCIE::value;
-    if(idle) cr1 &= ~USARTx::CR1::IDLEIE::value;
-    USARTx::CR1::store(cr1);
+    USARTx::CR1::atomic_set(0, interrupt_mask(rxne, txe, pe, tc, idle));
   }
 
-  static void enable_tx_interrupt(void)  { USARTx::CR1::TXEIE::set(); }
-  static void disable_tx_interrupt(void) { USARTx::CR1::TXEIE::clear(); }
+  /* NOTE: called from both ISR and main loop (see usart_irq_stream), use atomic access */
+  static void enable_tx_interrupt(void)  { USARTx::CR1::TXEIE::template set< access_policy::atomic >(); }
+  static void disable_tx_interrupt(void) { USARTx::CR1::TXEIE::template clear< access_policy::atomic >(); }
 };
 
 } // namespace mptl
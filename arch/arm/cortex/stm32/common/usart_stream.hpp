@@ -49,20 +49,28 @@ private:
 
   using SR = typename usart_type::USARTx::SR;
 
+  using ORE  = typename SR::ORE;
+  using FE   = typename SR::FE;
+  using NE   = typename SR::NE;
+  using PE   = typename SR::PE;
+  using RXNE = typename SR::RXNE;
+  using TXE  = typename SR::TXE;
+
   static void isr(void) {
-    auto flags = SR::load();
+    /* single load of the status register */
+    auto flags = SR::template snapshot< ORE, FE, NE, PE, RXNE, TXE >();
 
     if(debug_irqs) {
       irq_count++;
-      if(flags & (SR::ORE::value | SR::FE::value | SR::NE::value | SR::PE::value))
+      if(flags.template test_any< ORE, FE, NE, PE >())
         irq_errors++;
     }
 
-    if(flags & SR::RXNE::value) {
+    if(flags.template test< RXNE >()) {
       uint32_t data = usart_type::receive(); /* implicitely clears RXNE flag */
       rx_fifo.push(data);
     }
-    if(flags & SR::TXE::value) {
+    if(flags.template test< TXE >()) {
       char c;
       if(tx_fifo.pop(c)) {
         usart_type::send(c); /* implicitely clears TXE flag */
@@ -23,6 +23,8 @@
 
 #include <arch/rcc.hpp>
 #include <arch/reg/adc.hpp>
+#include <register_array.hpp>
+#include <register_wait.hpp>
 #include <type_traits>
 
 namespace mptl {
@@ -94,7 +96,7 @@ private:
 
   template<unsigned channel, unsigned rank, sample_time _sample_time>
   struct regular_channel_config_impl {
-    static constexpr unsigned smp_value = (unsigned)_sample_time;
+    static constexpr unsigned smp_value = static_cast<unsigned>(_sample_time);
 
     static_assert(channel <= 17, "invalid channel");
     static_assert((rank >= 1) && (rank <= 16), "invalid rank");
@@ -183,13 +185,15 @@ public:  /* ------ configuration traits ------ */
 public:  /* ------ static member functions ------ */
 
   /**
-   * Configure ADC register using Tp type traits.
+   * Configure ADC register using Tp type traits, using given write strategy
+   * (see write_strategy in register_type.hpp). Registers not covered
+   * by Tp are only reset for write_strategy::reset_to.
    *
    * NOTE: make sure no communication is ongoing when calling this function.
    */
-  template< typename... Tp >
+  template< write_strategy strategy, typename... Tp >
   static void configure(void) {
-    reglist< Tp... >::template strict_reset_to<
+    reglist< Tp... >::template strict_apply< strategy,
       typename ADCx::CR1,
       typename ADCx::CR2,
       typename ADCx::SMPR1,
@@ -200,6 +204,16 @@ public:  /* ------ static member functions ------ */
       >();
   }
 
+  /**
+   * Configure ADC register using Tp type traits.
+   *
+   * NOTE: make sure no communication is ongoing when calling this function.
+   */
+  template< typename... Tp >
+  static void configure(void) {
+    configure< write_strategy::reset_to, Tp... >();
+  }
+
   static void reset(void) {
     switch(adc_no) {
     case 1:
@@ -241,14 +255,49 @@ public:  /* ------ static member functions ------ */
       >();
   }
 
-  static void wait_eoc(void) {
-    while(ADCx::SR::EOC::test() == false);
+  static wait_result wait_eoc(wait_timeout const timeout = wait_timeout::forever()) {
+    return wait_until< typename ADCx::SR::EOC >(timeout);
   }
 
   static uint16_t get_conversion_value(void) {
     return ADCx::DR::load();
   }
 
+  /**
+   * Set channel at rank in the regular sequence, and the sample time
+   * of channel. Channel (0..17) and rank (1..16) are checked at
+   * compile-time.
+   */
+  template<unsigned channel, unsigned rank, sample_time smp>
+  static void set_regular_channel(void) {
+    static_assert(channel <= 17, "invalid channel");
+    static_assert((rank >= 1) && (rank <= 16), "invalid rank");
+    regular_channel_config< channel, rank, smp >::set();
+  }
+
+  /**
+   * Set channel at rank in the regular sequence, and the sample time
+   * of channel, for values known at runtime only (e.g. table-driven
+   * sequences).
+   *
+   * NOTE: channel (0..17) and rank (1..16) are not checked (only the
+   * register index, if CONFIG_REG_ARRAY_BOUNDS_CHECK is defined): an
+   * invalid rank or channel writes a neighbouring field. Use the
+   * template variant above for values known at compile-time.
+   */
+  static void set_regular_channel(unsigned channel, unsigned rank, sample_time smp) {
+    /* SMPR1 (channels 10..17), SMPR2 (channels 0..9) */
+    using SMPR = reg_array< typename ADCx::SMPR1, 4, 2 >;
+    /* SQR1 (ranks 13..16), SQR2 (ranks 7..12), SQR3 (ranks 1..6) */
+    using SQR  = reg_array< typename ADCx::SQR1, 4, 3 >;
+
+    unsigned const smp_shift = (channel % 10) * 3;
+    unsigned const sq_shift  = ((rank - 1) % 6) * 5;
+
+    SMPR::set(1 - channel / 10, static_cast<uint32_t>(smp) << smp_shift, static_cast<uint32_t>(0x7) << smp_shift);
+    SQR::set(2 - (rank - 1) / 6, static_cast<uint32_t>(channel) << sq_shift, static_cast<uint32_t>(0x1f) << sq_shift);
+  }
+
 };
 
 } // namespace mptl
@@ -24,6 +24,7 @@
 #include <arch/reg/rcc.hpp>
 #include <typelist.hpp>
 #include <freq.hpp>
+#include <register_wait.hpp>
 #include <type_traits>
 
 namespace mptl {
@@ -76,18 +77,12 @@ public:  /* ------ static member functions ------ */
     RCC::BDCR::BDRST::clear();
   }
 
-  static void wait_hse_ready(void) {
-    while(RCC::CR::HSERDY::test() == false);
-  }
-  static bool wait_hse_ready(unsigned timeout) {
-    while((RCC::CR::HSERDY::test() == false) && timeout) {
-      timeout--;
-    }
-    return timeout;
+  static wait_result wait_hse_ready(wait_timeout const timeout = wait_timeout::forever()) {
+    return wait_until< RCC::CR::HSERDY >(timeout);
   }
 
-  static void wait_lse_ready(void) {
-    while(RCC::BDCR::LSERDY::test() == false);
+  static wait_result wait_lse_ready(wait_timeout const timeout = wait_timeout::forever()) {
+    return wait_until< RCC::BDCR::LSERDY >(timeout);
   }
 };
 
@@ -100,16 +95,17 @@ struct system_clock_hse_impl
 {
   static void init(void) {
     rcc::hse_enable::set();
-    rcc::wait_hse_ready();
+    rcc::wait_hse_ready(wait_timeout::forever());  /* no fallback to HSI */
   }
 
   static void configure(void) {
     RCC::CFGR::reset_to< Tp... >();
 
+    /* no timeout: there is no fallback if the PLL does not lock */
     RCC::CR::PLLON::set();
-    while(RCC::CR::PLLRDY::test() == false);
+    wait_until< RCC::CR::PLLRDY >(wait_timeout::forever());
     RCC::CFGR::SW::PLL::set();
-    while(RCC::CFGR::SWS::PLL::test() == false);
+    wait_until< RCC::CFGR::SWS::PLL >(wait_timeout::forever());
   }
 };
 
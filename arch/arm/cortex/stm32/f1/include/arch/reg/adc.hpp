@@ -49,9 +49,9 @@ struct ADC
    * Status register
    */
   struct SR
-  : public reg< uint32_t, base_addr + 0x0, rw, 0x00000000 >
+  : public reg< uint32_t, base_addr + 0x0, rw_wc, 0x00000000 >
   {
-    using type = reg< uint32_t, base_addr + 0x0, rw, 0x00000000 >;
+    using type = reg< uint32_t, base_addr + 0x0, rw_wc, 0x00000000 >;
 
     using STRT   = regbits< type,  4,  1 >;  /**< Regular channel start flag          */
     using JSTRT  = regbits< type,  3,  1 >;  /**< Injected channel start flag         */
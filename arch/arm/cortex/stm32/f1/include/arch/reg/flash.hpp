@@ -83,9 +83,9 @@ struct FLASH
    * Status register
    */
   struct SR
-  : public reg< uint32_t, base_addr + 0xc, rw, 0x00000000 >
+  : public reg< uint32_t, base_addr + 0xc, rw_wc, 0x00000000 >
   {
-    using type = reg< uint32_t, base_addr + 0xc, rw, 0x00000000 >;
+    using type = reg< uint32_t, base_addr + 0xc, rw_wc, 0x00000000 >;
 
     using EOP       = regbits< type,  5,  1 >;  /**< End of operation        */
     using WRPRTERR  = regbits< type,  4,  1 >;  /**< Write protection error  */
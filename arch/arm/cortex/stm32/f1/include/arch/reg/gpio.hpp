@@ -29,6 +29,7 @@
 #define ARCH_REG_GPIO_HPP_INCLUDED
 
 #include <register.hpp>
+#include <register_array.hpp>
 
 namespace mptl {
 
@@ -43,13 +44,26 @@ struct GPIO
   static constexpr unsigned    gpio_no   = port - 'A';
   static constexpr reg_addr_t  base_addr = 0x40010800 + gpio_no * 0x0400;
 
-  using CRL   = reg< uint32_t, base_addr + 0x00, rw, 0x44444444 >;  /**< Port configuration register low    */
-  using CRH   = reg< uint32_t, base_addr + 0x04, rw, 0x44444444 >;  /**< Port configuration register high   */
-  using IDR   = reg< uint32_t, base_addr + 0x08, ro, 0x00000000 >;  /**< Port input data register           */
-  using ODR   = reg< uint32_t, base_addr + 0x0c, rw, 0x00000000 >;  /**< Port output data register          */
-  using BSRR  = reg< uint32_t, base_addr + 0x10, wo, 0x00000000 >;  /**< Port bit set/reset register        */
-  using BRR   = reg< uint32_t, base_addr + 0x14, wo, 0x00000000 >;  /**< Port bit reset register            */
-  using LCKR  = reg< uint32_t, base_addr + 0x18, rw, 0x00000000 >;  /**< Port configuration lock register   */
+  using CRL   = reg< uint32_t, base_addr + 0x00, rw_sw, 0x44444444 >;  /**< Port configuration register low    */
+  using CRH   = reg< uint32_t, base_addr + 0x04, rw_sw, 0x44444444 >;  /**< Port configuration register high   */
+  using IDR   = reg< uint32_t, base_addr + 0x08, ro,    0x00000000 >;  /**< Port input data register           */
+  using ODR   = reg< uint32_t, base_addr + 0x0c, rw,    0x00000000 >;  /**< Port output data register          */
+
+  /**
+   * Port bit set/reset register (halfword-accessible: BS and BR are
+   * written by a single 16bit store)
+   */
+  struct BSRR
+  : public reg< uint32_t, base_addr + 0x10, wo, 0x00000000, reg_barrier::none, reg_lane::halfword >
+  {
+    using type = reg< uint32_t, base_addr + 0x10, wo, 0x00000000, reg_barrier::none, reg_lane::halfword >;
+
+    using BS  = regbits< type,  0, 16 >;  /**< Port set bits    */
+    using BR  = regbits< type, 16, 16 >;  /**< Port reset bits  */
+  };
+
+  using BRR   = reg< uint32_t, base_addr + 0x14, wo,    0x00000000 >;  /**< Port bit reset register            */
+  using LCKR  = reg< uint32_t, base_addr + 0x18, rw,    0x00000000 >;  /**< Port configuration lock register   */
 
   /**
    * GPIO port configuration register: returns CRL or CRH type dependent on pin_no.
@@ -67,6 +81,20 @@ struct GPIO
   };
 };
 
+/**
+ * GPIO port data registers, indexed by port number at runtime
+ * (0='A'), e.g. for pin maps loaded from configuration.
+ */
+struct GPIO_PORTS
+{
+  static constexpr std::size_t count = 7;  /* GPIOA..GPIOG */
+
+  using IDR   = reg_array< GPIO<'A'>::IDR,  0x0400, count >;
+  using ODR   = reg_array< GPIO<'A'>::ODR,  0x0400, count >;
+  using BSRR  = reg_array< GPIO<'A'>::BSRR, 0x0400, count >;
+  using BRR   = reg_array< GPIO<'A'>::BRR,  0x0400, count >;
+};
+
 } // namespace mptl
 
 #endif // ARCH_REG_GPIO_HPP_INCLUDED
@@ -308,7 +308,7 @@ struct RCC
    * AHB Peripheral Clock enable register (RCC_AHBENR)
    */
   struct AHBENR
-  : public reg< uint32_t, base_addr + 0x14, rw, 0x00000014 >
+  : public reg< uint32_t, base_addr + 0x14, rw_sw, 0x00000014 >
   {
     using DMA1EN      = regbits< type,  0,  1 >;  /**< DMA1 clock enable             */
     using DMA2EN      = regbits< type,  1,  1 >;  /**< DMA2 clock enable (only available on high-density and connectivity line devices!)  */
@@ -327,7 +327,7 @@ struct RCC
    * APB2 peripheral clock enable register (RCC_APB2ENR)
    */
   struct APB2ENR
-  : public reg< uint32_t, base_addr + 0x18, rw, 0x00000000 >
+  : public reg< uint32_t, base_addr + 0x18, rw_sw, 0x00000000 >
   {
     using AFIOEN    = regbits< type,  0,  1 >;  /**< Alternate function I/O clock enable  */
     using IOPAEN    = regbits< type,  2,  1 >;  /**< I/O port A clock enable              */
@@ -356,7 +356,7 @@ struct RCC
    * APB1 peripheral clock enable register (RCC_APB1ENR)
    */
   struct APB1ENR
-  : public reg< uint32_t, base_addr + 0x1c, rw, 0x00000000 >
+  : public reg< uint32_t, base_addr + 0x1c, rw_sw, 0x00000000 >
   {
     using TIM2EN    = regbits< type,  0,  1 >;  /**< Timer 2 clock enable           */
     using TIM3EN    = regbits< type,  1,  1 >;  /**< Timer 3 clock enable           */
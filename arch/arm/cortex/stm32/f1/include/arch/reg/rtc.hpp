@@ -52,9 +52,12 @@ struct RTC
 
   /**
    * RTC Control register low
+   *
+   * Barrier: flags are cleared in interrupt handlers, the write must
+   * complete before exception return (spurious re-entry otherwise).
    */
   struct CRL
-  : public reg< std::uint_fast16_t, base_addr + 0x4, rw, 0x0020 >
+  : public reg< std::uint_fast16_t, base_addr + 0x4, rw_wc, 0x0020, reg_barrier::dsb >
   {
     using SECF   = regbits< type,  0,  1 >;  /**< Second Flag                  */
     using ALRF   = regbits< type,  1,  1 >;  /**< Alarm Flag                   */
@@ -0,0 +1,35 @@
+/*
+ * OpenMPTL - C++ Microprocessor Template Library
+ *
+ * Copyright (C) 2012-2017 Axel Burri <axel@tty0.ch>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef ARCH_REG_SET_RESET_HPP_INCLUDED
+#define ARCH_REG_SET_RESET_HPP_INCLUDED
+
+#include "../../../common/reg_set_reset.hpp"
+
+namespace mptl {
+
+template< char port > struct GPIO;  /* arch/reg/gpio.hpp */
+
+/* GPIOA..GPIOG: ODR at 0x0c, BSRR at 0x10 */
+using reg_set_reset = reg_set_reset_stm32_common< GPIO, 0x40010800, 7, 0x0c, 0x10 >;
+
+} // namespace mptl
+
+#endif // ARCH_REG_SET_RESET_HPP_INCLUDED
@@ -25,6 +25,7 @@
 #include <arch/pwr.hpp>
 #include <arch/rcc.hpp>
 #include <arch/reg/rtc.hpp>
+#include <register_wait.hpp>
 
 namespace mptl {
 
@@ -41,17 +42,22 @@ private:
     wait_config_done();
   }
   static void wait_config_done(void) {
-    while(RTC::CRL::RTOFF::test() == false);
+    wait_until< RTC::CRL::RTOFF >(wait_timeout::forever());
   }
 
 public:
 
+  using counter   = reg_pair< RTC::CNTH, RTC::CNTL >;  /**< 32bit counter         */
+  using divider   = reg_pair< RTC::DIVH, RTC::DIVL >;  /**< 20bit divider         */
+  using prescaler = reg_pair< RTC::PRLH, RTC::PRLL >;  /**< 20bit prescaler load  */
+  using alarm     = reg_pair< RTC::ALRH, RTC::ALRL >;  /**< 32bit alarm           */
+
   using irq_global = irq::rtc;        /**< RTC global Interrupt                   */
   using irq_alarm  = irq::rtc_alarm;  /**< RTC Alarm through EXTI Line Interrupt  */
 
-  static void wait_sync(void) {
+  static wait_result wait_sync(wait_timeout const timeout = wait_timeout::forever()) {
     RTC::CRL::RSF::clear();
-    while(RTC::CRL::RSF::test() == false);
+    return wait_until< RTC::CRL::RSF >(timeout);
   }
 
   // TODO: enable/disable more than one at once
@@ -85,21 +91,24 @@ public:
     RTC::CRL::SECF::clear();
   }
 
+  /**
+   * Returns the RTC counter value. The counter is read consistently
+   * (see reg_pair), resulting in monotonic timestamps without
+   * disabling interrupts.
+   */
   static uint32_t get_counter(void) {
-    return (((uint32_t)RTC::CNTH::load() << 16) | (uint32_t)RTC::CNTL::load());
+    return counter::load();
   }
 
   static void set_counter(uint32_t value) {
     enter_config_mode();
-    RTC::CNTH::store(value >> 16);
-    RTC::CNTL::store(value & 0xFFFF);
+    counter::store(value);
     exit_config_mode();
   }
 
   static void set_prescaler(uint32_t value) {
     enter_config_mode();
-    RTC::PRLH::store((value & 0xF0000) >> 16);
-    RTC::PRLL::store(value & 0xFFFF);
+    prescaler::store(value);
     exit_config_mode();
   }
 
@@ -111,16 +120,13 @@ public:
 
   static void set_alarm(uint32_t value) {
     enter_config_mode();
-    RTC::ALRH::store(value >> 16);
-    RTC::ALRL::store(value & 0xFFFF);
+    alarm::store(value);
     exit_config_mode();
   }
 
+  /** Returns the RTC prescaler divider value (read consistently, see reg_pair) */
   static uint32_t get_divider(void) {
-    return ((uint32_t)RTC::DIVH::load() << 16 ) | (uint32_t)RTC::DIVL::load();
-
-    /* paranoid variant: applies bitmask on high/low register before shifting */
-    // return ((uint32_t)RTC::DIVH::regbits_type::test() << 16 ) | (uint32_t)RTC::DIVL::bits_type::test();
+    return divider::load();
   }
 
   using resources = rcc_rtc_clock_resources;
@@ -25,6 +25,7 @@
 #include <arch/reg/rcc.hpp>
 #include <typelist.hpp>
 #include <freq.hpp>
+#include <register_wait.hpp>
 
 namespace mptl {
 
@@ -44,24 +45,12 @@ public:  /* ------ configuration traits ------ */
 
 public:  /* ------ static member functions ------ */
 
-  static void wait_hse_ready() {
-    while(RCC::CR::HSERDY::test() == false);
-  }
-  static bool wait_hse_ready(unsigned timeout) {
-    while((RCC::CR::HSERDY::test() == false) && timeout) {
-      timeout--;
-    }
-    return timeout;
+  static wait_result wait_hse_ready(wait_timeout const timeout = wait_timeout::forever()) {
+    return wait_until< RCC::CR::HSERDY >(timeout);
   }
 
-  static void wait_hsi_ready() {
-    while(RCC::CR::HSIRDY::test() == false);
-  }
-  static bool wait_hsi_ready(unsigned timeout) {
-    while((RCC::CR::HSIRDY::test() == false) && timeout) {
-      timeout--;
-    }
-    return timeout;
+  static wait_result wait_hsi_ready(wait_timeout const timeout = wait_timeout::forever()) {
+    return wait_until< RCC::CR::HSIRDY >(timeout);
   }
 };
 
@@ -79,7 +68,7 @@ struct system_clock_hse_base
 
   static void init(void) {
     rcc::hse_enable::set();
-    rcc::wait_hse_ready();
+    rcc::wait_hse_ready(wait_timeout::forever());  /* no fallback to HSI */
   }
 
   static void configure(void) {
@@ -88,10 +77,11 @@ struct system_clock_hse_base
       RCC::PLLCFGR
       >();
 
+    /* no timeout: there is no fallback if the PLL does not lock */
     RCC::CR::PLLON::set();
-    while(RCC::CR::PLLRDY::test() == false);
+    wait_until< RCC::CR::PLLRDY >(wait_timeout::forever());
     RCC::CFGR::SW::PLL::set();
-    while(RCC::CFGR::SWS::PLL::test() == false);
+    wait_until< RCC::CFGR::SWS::PLL >(wait_timeout::forever());
   }
 };
 
@@ -196,6 +186,7 @@ struct system_clock_hse
 
 /* Clock resource declarations (enable peripheral clocks) */
 template<char>     struct rcc_gpio_clock_resources;
+template<unsigned> struct rcc_spi_clock_resources;
 template<unsigned> struct rcc_usart_clock_resources;
 
 /*
@@ -211,6 +202,10 @@ template<> struct rcc_gpio_clock_resources<'G'> : RCC::AHB1ENR::GPIOGEN { };
 template<> struct rcc_gpio_clock_resources<'H'> : RCC::AHB1ENR::GPIOHEN { };
 template<> struct rcc_gpio_clock_resources<'I'> : RCC::AHB1ENR::GPIOIEN { };
 
+template<> struct rcc_spi_clock_resources<1>    : RCC::APB2ENR::SPI1EN { };
+template<> struct rcc_spi_clock_resources<2>    : RCC::APB1ENR::SPI2EN { };
+template<> struct rcc_spi_clock_resources<3>    : RCC::APB1ENR::SPI3EN { };
+
 template<> struct rcc_usart_clock_resources<1>  : RCC::APB2ENR::USART1EN { };
 template<> struct rcc_usart_clock_resources<2>  : RCC::APB1ENR::USART2EN { };
 template<> struct rcc_usart_clock_resources<3>  : RCC::APB1ENR::USART3EN { };
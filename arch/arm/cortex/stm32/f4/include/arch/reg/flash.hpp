@@ -67,7 +67,7 @@ struct FLASH
    * Status register
    */
   struct SR
-  : public reg< uint32_t, base_addr + 0x0C, rw, 0x00000000 >
+  : public reg< uint32_t, base_addr + 0x0C, rw_wc, 0x00000000 >
   {
     using BSY     = regbits< type, 16,  1 >;  /**< Busy                           */
     using PGSERR  = regbits< type,  7,  1 >;  /**< Programming sequence error     */
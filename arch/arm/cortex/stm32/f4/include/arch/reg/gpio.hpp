@@ -29,6 +29,7 @@
 #define ARCH_REG_GPIO_HPP_INCLUDED
 
 #include <register.hpp>
+#include <register_array.hpp>
 #include <type_traits>
 
 namespace mptl {
@@ -55,16 +56,29 @@ struct GPIO
                                               port == 'B' ? 0x00000100 :
                                               0x00000000 );
 
-  using MODER    = reg< uint32_t, base_addr + 0x00, rw, moder_reset   >;  /**< GPIO port mode register               */
-  using OTYPER   = reg< uint32_t, base_addr + 0x04, rw                >;  /**< GPIO port output type register        */
-  using OSPEEDR  = reg< uint32_t, base_addr + 0x08, rw, ospeedr_reset >;  /**< GPIO port output speed register       */
-  using PUPDR    = reg< uint32_t, base_addr + 0x0c, rw, pupdr_reset   >;  /**< GPIO port pull-up/pull-down register  */
-  using IDR      = reg< uint32_t, base_addr + 0x10, ro /*0x0000XXXX*/ >;  /**< GPIO port input data register         */
-  using ODR      = reg< uint32_t, base_addr + 0x14, rw                >;  /**< GPIO port output data register        */
-  using BSRR     = reg< uint32_t, base_addr + 0x18, wo                >;  /**< GPIO port bit set/reset register      */
-  using LCKR     = reg< uint32_t, base_addr + 0x1c, rw                >;  /**< GPIO port configuration lock register */
-  using AFRL     = reg< uint32_t, base_addr + 0x20, rw                >;  /**< GPIO alternate function low register  */
-  using AFRH     = reg< uint32_t, base_addr + 0x24, rw                >;  /**< GPIO alternate function high register */
+  using MODER    = reg< uint32_t, base_addr + 0x00, rw_sw, moder_reset   >;  /**< GPIO port mode register               */
+  using OTYPER   = reg< uint32_t, base_addr + 0x04, rw_sw                >;  /**< GPIO port output type register        */
+  using OSPEEDR  = reg< uint32_t, base_addr + 0x08, rw_sw, ospeedr_reset >;  /**< GPIO port output speed register       */
+  using PUPDR    = reg< uint32_t, base_addr + 0x0c, rw_sw, pupdr_reset   >;  /**< GPIO port pull-up/pull-down register  */
+  using IDR      = reg< uint32_t, base_addr + 0x10, ro /*0x0000XXXX*/    >;  /**< GPIO port input data register         */
+  using ODR      = reg< uint32_t, base_addr + 0x14, rw                   >;  /**< GPIO port output data register        */
+
+  /**
+   * GPIO port bit set/reset register (halfword-accessible: BS and BR
+   * are written by a single 16bit store)
+   */
+  struct BSRR
+  : public reg< uint32_t, base_addr + 0x18, wo, 0, reg_barrier::none, reg_lane::halfword >
+  {
+    using type = reg< uint32_t, base_addr + 0x18, wo, 0, reg_barrier::none, reg_lane::halfword >;
+
+    using BS  = regbits< type,  0, 16 >;  /**< Port set bits    */
+    using BR  = regbits< type, 16, 16 >;  /**< Port reset bits  */
+  };
+
+  using LCKR     = reg< uint32_t, base_addr + 0x1c, rw                   >;  /**< GPIO port configuration lock register */
+  using AFRL     = reg< uint32_t, base_addr + 0x20, rw_sw                >;  /**< GPIO alternate function low register  */
+  using AFRH     = reg< uint32_t, base_addr + 0x24, rw_sw                >;  /**< GPIO alternate function high register */
 
   template< unsigned pin_no > using MODERx   = regbits< MODER  , pin_no * 2      , 2 >;
   template< unsigned pin_no > using OTYPERx  = regbits< OTYPER , pin_no          , 1 >;
@@ -88,6 +102,19 @@ struct GPIO
     >::type;
 };
 
+/**
+ * GPIO port data registers, indexed by port number at runtime
+ * (0='A'), e.g. for pin maps loaded from configuration.
+ */
+struct GPIO_PORTS
+{
+  static constexpr std::size_t count = 9;  /* GPIOA..GPIOI */
+
+  using IDR   = reg_array< GPIO<'A'>::IDR,  0x0400, count >;
+  using ODR   = reg_array< GPIO<'A'>::ODR,  0x0400, count >;
+  using BSRR  = reg_array< GPIO<'A'>::BSRR, 0x0400, count >;
+};
+
 } // namespace mptl
 
 #endif // ARCH_REG_GPIO_HPP_INCLUDED
@@ -253,7 +253,7 @@ struct RCC
    * AHB1 peripheral clock register
    */
   struct AHB1ENR
-  : public reg< uint32_t, base_addr + 0x30, rw, 0x00100000 >
+  : public reg< uint32_t, base_addr + 0x30, rw_sw, 0x00100000 >
   {
     using OTGHSULPIEN  = regbits< type, 30,  1 >;  /**< USB OTG HSULPI clock enable         */
     using OTGHSEN      = regbits< type, 29,  1 >;  /**< USB OTG HS clock enable             */
@@ -280,7 +280,7 @@ struct RCC
    * AHB2 peripheral clock enable register
    */
   struct AHB2ENR
-  : public reg< uint32_t, base_addr + 0x34, rw, 0x00000000 >
+  : public reg< uint32_t, base_addr + 0x34, rw_sw, 0x00000000 >
   {
     using OTGFSEN  = regbits< type,  7,  1 >;  /**< USB OTG FS clock enable               */
     using RNGEN    = regbits< type,  6,  1 >;  /**< Random number generator clock enable  */
@@ -291,7 +291,7 @@ struct RCC
    * AHB3 peripheral clock enable register
    */
   struct AHB3ENR
-  : public reg< uint32_t, base_addr + 0x38, rw, 0x00000000 >
+  : public reg< uint32_t, base_addr + 0x38, rw_sw, 0x00000000 >
   {
     using FSMCEN  = regbits< type,  0,  1 >;  /**< Flexible static memory controller module clock enable  */
   };
@@ -300,7 +300,7 @@ struct RCC
    * APB1 peripheral clock enable register
    */
   struct APB1ENR
-  : public reg< uint32_t, base_addr + 0x40, rw, 0x00000000 >
+  : public reg< uint32_t, base_addr + 0x40, rw_sw, 0x00000000 >
   {
     using DACEN     = regbits< type, 29,  1 >;  /**< DAC interface clock enable    */
     using PWREN     = regbits< type, 28,  1 >;  /**< Power interface clock enable  */
@@ -331,7 +331,7 @@ struct RCC
    * APB2 peripheral clock enable register
    */
   struct APB2ENR
-  : public reg< uint32_t, base_addr + 0x44, rw, 0x00000000 >
+  : public reg< uint32_t, base_addr + 0x44, rw_sw, 0x00000000 >
   {
     using TIM11EN   = regbits< type, 18,  1 >;  /**< TIM11 clock enable                            */
     using TIM10EN   = regbits< type, 17,  1 >;  /**< TIM10 clock enable                            */
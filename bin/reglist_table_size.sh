@@ -0,0 +1,52 @@
+#!/bin/bash
+
+#
+# Compare code size of reglist<>::reset_to() emission modes
+# (unrolled stores vs. table loop, see reglist_emission), by building
+# each project twice:
+#
+#   unrolled : CONFIG_REGLIST_TABLE_THRESHOLD=0 (never emit tables)
+#   table    : CONFIG_REGLIST_TABLE_THRESHOLD=1 (always emit tables)
+#
+# Prints the section sizes of the resulting binary, and the size of
+# the init function (Kernel::init, or main if inlined).
+#
+# Usage (from the OpenMPTL top directory):
+#
+#   bin/reglist_table_size.sh                   # simulation build (host)
+#   CROSS=armv7m-none-eabi- bin/reglist_table_size.sh
+#
+# NOTE: the projects are cleaned before and after each build.
+#
+
+PROJECTS="stm32f103stk-demo stm32f4discovery stm32f4discovery-ledtest"
+
+if [ -z "$CROSS" ] ; then
+  MAKE_ARGS="SIMULATION=1"
+else
+  MAKE_ARGS="CROSS=$CROSS"
+fi
+
+SIZE="${CROSS}size -B -d"
+NM="${CROSS}nm -S -C --radix=d"
+
+TOP=$(cd "$(dirname "$0")/.." && pwd)
+
+printf "%-28s %-10s %8s %8s %8s %8s\n" project emission text data bss init
+for project in $PROJECTS ; do
+  for threshold in 0 1 ; do
+    if [ $threshold -eq 0 ] ; then emission=unrolled ; else emission=table ; fi
+    cd "$TOP/projects/$project" || exit 1
+    make $MAKE_ARGS clean > /dev/null 2>&1
+    if ! CXXFLAGS="-DCONFIG_REGLIST_TABLE_THRESHOLD=$threshold" make $MAKE_ARGS > /dev/null 2>&1 ; then
+      echo "!!! build failed: $project ($emission)"
+      exit 1
+    fi
+    name=$(sed -n 's/^PROJECT *= *//p' Makefile)
+    if [ -z "$CROSS" ] ; then bin=$name ; else bin=$name.elf ; fi
+    sizes=$($SIZE $bin | awk 'NR==2 { print $1, $2, $3 }')
+    init=$($NM $bin | awk '/ [tT] (Kernel::init\(\)|main)$/ { print $2 + 0; exit }')
+    printf "%-28s %-10s %8s %8s %8s %8s\n" $project $emission $sizes ${init:--}
+    make $MAKE_ARGS clean > /dev/null 2>&1
+  done
+done
@@ -154,6 +154,8 @@ template<
   >
 class nokia3310 : public lcd_screen< 84, 48, lcd_font< 5 >, 1 >
 {
+public:
+
   using spi_cfg = mptl::typelist<
     typename spi_type::master,
     typename spi_type::template max_frequency< mhz(4) >,
@@ -165,6 +167,8 @@ class nokia3310 : public lcd_screen< 84, 48, lcd_font< 5 >, 1 >
     typename spi_type::software_slave_management
     >;
 
+private:
+
   static void enable_slave_select(void) {
     lcd_e::reset();
   }
@@ -208,6 +212,16 @@ public:
     spi_type::template reconfigure< spi_cfg >();
   }
 
+  /**
+   * Switch the SPI configuration from prev_spi_cfg (e.g. the spi_cfg
+   * of another device sharing the SPI bus) to spi_cfg, writing only
+   * the changed registers (see spi_type::transition<>()).
+   */
+  template< typename prev_spi_cfg >
+  static void enable_from(void) {
+    spi_type::template transition< prev_spi_cfg, spi_cfg >();
+  }
+
   void update(void) {
     enable_slave_select();
 
@@ -86,8 +86,6 @@ public:
     }
   };
 
-private:
-
   using spi_cfg = mptl::reglist<
     typename spi_type::master,
     typename spi_type::template max_frequency< mhz(8) >,
@@ -99,6 +97,8 @@ private:
     typename spi_type::software_slave_management
     >;
 
+private:
+
   /* Tcwh: CSN Inactive time: min. 50ns */
   /* Time between calls of disable() -> enable() */
   static void wait_tcwh(void) {
@@ -208,6 +208,16 @@ public:
   static void enable() {
     spi_type::template reconfigure< spi_cfg >();
   }
+
+  /**
+   * Switch the SPI configuration from prev_spi_cfg (e.g. the spi_cfg
+   * of another device sharing the SPI bus) to spi_cfg, writing only
+   * the changed registers (see spi_type::transition<>()).
+   */
+  template< typename prev_spi_cfg >
+  static void enable_from(void) {
+    spi_type::template transition< prev_spi_cfg, spi_cfg >();
+  }
 };
 
 } } // namespace mptl::device
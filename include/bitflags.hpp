@@ -0,0 +1,127 @@
+/*
+ * OpenMPTL - C++ Microprocessor Template Library
+ *
+ * Copyright (C) 2012-2017 Axel Burri <axel@tty0.ch>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BITFLAGS_HPP_INCLUDED
+#define BITFLAGS_HPP_INCLUDED
+
+#include <cstdint>
+#include <compiler.h>
+
+#ifdef OPENMPTL_SIMULATION
+#  include <atomic>
+#else
+#  include <arch/bitband.hpp>
+#endif
+
+namespace mptl {
+
+/**
+ * N flags in RAM (e.g. event or ready bits shared with interrupt
+ * handlers), each set/cleared/tested atomically without critical
+ * sections.
+ *
+ *   - embedded  : single bit-band access per flag (see bitband_sram)
+ *   - simulation: std::atomic fetch_or/fetch_and
+ *
+ * Usage:
+ *
+ *     static bitflags<8> events;
+ *     events.set<3>();
+ *     if(events.test<3>()) ...
+ *
+ * NOTE: bitflags must reside in the SRAM bit-band region (first 1MB
+ * of SRAM, e.g. .data or .bss), not in the CCM or on flash.
+ */
+template<unsigned N>
+class bitflags
+{
+  static_assert(N > 0, "bitflags must hold at least one flag");
+
+public:
+  using value_type = uint32_t;
+
+  static constexpr unsigned size       = N;
+  static constexpr unsigned word_bits  = 32;
+  static constexpr unsigned word_count = (N + word_bits - 1) / word_bits;
+
+private:
+
+#ifdef OPENMPTL_SIMULATION
+  std::atomic<value_type> words[word_count];
+#else
+  volatile value_type words[word_count] __attribute__((aligned(4)));
+#endif
+
+  template<unsigned bit>
+  static constexpr value_type mask(void) {
+    return static_cast<value_type>(1) << (bit % word_bits);
+  }
+
+public:
+
+  /** All flags cleared (constexpr: no dynamic initialization of static instances) */
+  constexpr bitflags() : words{} { }
+
+  /* non-copyable: words are shared with interrupt handlers */
+  bitflags(const bitflags &) = delete;
+  bitflags & operator=(const bitflags &) = delete;
+
+  /** Set flag at index bit (atomic) */
+  template<unsigned bit>
+  __always_inline void set(void) {
+    static_assert(bit < N, "flag index out of range");
+#ifdef OPENMPTL_SIMULATION
+    words[bit / word_bits].fetch_or(mask<bit>());
+#else
+    bitband_sram::bitset(&words[bit / word_bits], bit % word_bits);
+#endif
+  }
+
+  /** Clear flag at index bit (atomic) */
+  template<unsigned bit>
+  __always_inline void clear(void) {
+    static_assert(bit < N, "flag index out of range");
+#ifdef OPENMPTL_SIMULATION
+    words[bit / word_bits].fetch_and(static_cast<value_type>(~mask<bit>()));
+#else
+    bitband_sram::bitclear(&words[bit / word_bits], bit % word_bits);
+#endif
+  }
+
+  /** Returns the flag at index bit */
+  template<unsigned bit>
+  __always_inline bool test(void) const {
+    static_assert(bit < N, "flag index out of range");
+#ifdef OPENMPTL_SIMULATION
+    return words[bit / word_bits].load() & mask<bit>();
+#else
+    return bitband_sram::bittest(&words[bit / word_bits], bit % word_bits);
+#endif
+  }
+
+  /** Returns the word at index (flags [index * 32 .. index * 32 + 31]) */
+  value_type word(unsigned index) const {
+    return words[index];
+  }
+};
+
+} // namespace mptl
+
+#endif // BITFLAGS_HPP_INCLUDED
@@ -74,6 +74,58 @@ namespace mpl
   template<typename typelist_type, int irqn>
   using unique_irq_handler = typename irqn_list<typelist_type, irqn>::unique_element::type;
 
+
+  template<int irqn, typename T>
+  struct irqn_handler_entry
+  { };
+
+  /**
+   * Inherits irqn_handler_entry<irqn, T> for each irq_handler<> T
+   * (Tp..., which must have distinct irq numbers).
+   */
+  template<typename... Tp>
+  struct irqn_handler_map
+  : irqn_handler_entry< Tp::irq_type::irqn, Tp >...
+  { };
+
+  /** Deduces T from the base irqn_handler_entry<irqn, T>, or void if not present (use in decltype only) */
+  template<int irqn, typename T>
+  type_wrap<T> irqn_handler_at(irqn_handler_entry<irqn, T> const *);
+  template<int irqn>
+  type_wrap<void> irqn_handler_at(void const *);
+
+  /**
+   * Provides the mptl::irq_handler<> element type by irq number, from
+   * a precomputed lookup on a list of irq_handler<> (irq_handler_list
+   * above):
+   *
+   *     irq_handler_lookup< handler_list >::handler< irqn >
+   *
+   * In contrast to unique_irq_handler<>, the list is filtered only
+   * once, and each lookup is a constant-depth overload resolution.
+   *
+   * NOTE: Asserts at compile-time (static_assert) that the irq
+   * numbers in the list are unique.
+   */
+  template<typename handler_list>
+  struct irq_handler_lookup;
+
+  template<typename... Tp>
+  struct irq_handler_lookup< sane_typelist<Tp...> >
+  {
+    static constexpr bool unique = (
+      unique_list< std::integral_constant< int, Tp::irq_type::irqn >... >::type::size == sizeof...(Tp)
+      );
+
+    static_assert(unique, "list contains more than one irq_handler<> for the same irq number");
+
+    /* do not instantiate the map on duplicates (duplicate base class) */
+    using map = typename std::conditional< unique, irqn_handler_map<Tp...>, irqn_handler_map<> >::type;
+
+    template<int irqn>
+    using handler = typename decltype(irqn_handler_at<irqn>(static_cast< map const * >(nullptr)))::type;
+  };
+
 #ifdef OPENMPTL_SIMULATION
   template<typename... Tp>
   struct dump_irq_types {
@@ -68,11 +68,6 @@
 #include <compiler.h>
 #include "register_mpl.hpp"
 
-#ifdef CONFIG_DISABLE_AUTO_BITBAND
-# define CONFIG_DISABLE_AUTO_BITBAND_WRITE
-# define CONFIG_DISABLE_AUTO_BITBAND_READ
-#endif
-
 namespace mptl {
 
 
@@ -95,6 +90,41 @@ class regmask
   regmask() {};
 #endif // CONFIG_USE_STD_TUPLE
 
+  using atomic_tag = std::integral_constant<access_policy, access_policy::atomic>;
+  using fast_tag   = std::integral_constant<access_policy, access_policy::fast>;
+  /* read-modify-write, dispatched on access_policy */
+
+  static __always_inline void rmw(typename Tp::value_type const set_bits, typename Tp::value_type const clear_bits, fast_tag) {
+    Tp::reg_type::set(set_bits, clear_bits);
+  }
+  static __always_inline void rmw(typename Tp::value_type const set_bits, typename Tp::value_type const clear_bits, atomic_tag) {
+    static_assert(!Tp::reg_type::shadowed, "atomic access on a shadowed register");
+    Tp::reg_type::atomic_set(set_bits, clear_bits);
+  }
+  /* no read-modify-write (full_coverage or lane_enabled: reg_type may be write-only) */
+  struct no_rmw_tag { };
+  static __always_inline void rmw(typename Tp::value_type const, typename Tp::value_type const, no_rmw_tag) { }
+
+  /* single store of the whole register (full_coverage) */
+  static __always_inline void full_store(typename Tp::value_type const value, std::true_type) {
+    Tp::reg_type::store(value);
+  }
+  static __always_inline void full_store(typename Tp::value_type const, std::false_type) { }
+
+  /* single store to the set/reset register of reg_type (see arch/reg_set_reset.hpp) */
+  static __always_inline void set_reset_store(typename Tp::value_type const set_bits, typename Tp::value_type const reset_bits, std::true_type) {
+    using set_reset_reg = reg_access< typename Tp::value_type, reg_set_reset::set_reset_addr(Tp::reg_type::addr), wo, 0, Tp::reg_type::barrier, reg_set_reset::lane >;
+    set_reset_reg::store(set_bits | (reset_bits << reg_set_reset::width));
+  }
+  static __always_inline void set_reset_store(typename Tp::value_type const, typename Tp::value_type const, std::false_type) { }
+
+protected:
+  /* single narrow store of the lane covered by clear_mask (see reg_lane) */
+  static __always_inline void lane_store(typename Tp::value_type const set_bits, std::true_type) {
+    Tp::reg_type::template lane_store< mpl::lowest_bit(_clear_mask), mpl::lane_width(Tp::reg_type::lane, _clear_mask) >(set_bits);
+  }
+  static __always_inline void lane_store(typename Tp::value_type const, std::false_type) { }
+
 public:
   using type         = regmask<typename Tp::reg_type, _set_mask, _clear_mask>;
   using reg_type     = typename Tp::reg_type;
@@ -121,44 +151,137 @@ public:
    */
   static constexpr value_type cropped_clear_mask = clear_mask & ~set_mask;
 
-#if !defined(CONFIG_DISABLE_AUTO_BITBAND_WRITE) || !defined(CONFIG_DISABLE_AUTO_BITBAND_READ)
+  /**
+   * True if clear_mask covers all bits of the register (value_type).
+   * In this case, set() does not need to read the register, and
+   * results in a single store() instead of a read-modify-write.
+   */
+  static constexpr bool full_coverage = (clear_mask == static_cast<value_type>(~static_cast<value_type>(0)));
+
   using bitcount = mpl::bitcount<clear_mask>;
-  static constexpr bool bitop_enabled = reg_type::bitop_enabled && (bitcount::value == 1);
-#endif
+  using bitop    = mpl::reg_bitop<reg_type, clear_mask>;
+
+  /**
+   * True if set() is performed by bit-band stores, according to the
+   * cost model in arch/bitband.hpp. Only possible if set_mask sets or
+   * clears all bits of clear_mask.
+   *
+   * NOTE: multiple bits are written one after each other (each bit
+   * atomically). Intermediate register values are visible to the
+   * hardware.
+   */
+  template<access_policy policy = access_policy::fast>
+  static constexpr bool bitop_set(void) {
+    return reg_type::bitop_write_enabled && ((set_mask == clear_mask) || (set_mask == 0)) &&
+      bitband_periph::prefer_bitop_write(bitcount::value, set_mask != 0, cropped_clear_mask != 0, policy == access_policy::atomic);
+  }
+
+  /** True if clear() is performed by bit-band stores (see bitop_set()). */
+  template<access_policy policy = access_policy::fast>
+  static constexpr bool bitop_clear(void) {
+    return reg_type::bitop_write_enabled &&
+      bitband_periph::prefer_bitop_write(bitcount::value, false, true, policy == access_policy::atomic);
+  }
+
+  /**
+   * True if set() and clear() are performed by a single store to the
+   * set/reset register of reg_type (e.g. GPIOx::BSRR for GPIOx::ODR,
+   * see arch/reg_set_reset.hpp), instead of a read-modify-write. This
+   * is faster, and atomic against interrupt handlers modifying other
+   * bits of the register.
+   */
+  static constexpr bool set_reset_enabled =
+    reg_set_reset::output(reg_type::addr) && !reg_type::shadowed &&
+    (clear_mask != 0) && ((clear_mask >> reg_set_reset::width) == 0);
+
+  /**
+   * True if set() and clear() are performed by a single narrow store
+   * (strb/strh) of the lane covered by clear_mask, instead of a
+   * read-modify-write. Requires reg_type to be declared with lane
+   * access (see reg_lane), and clear_mask to cover exactly one aligned
+   * byte or halfword.
+   */
+  static constexpr bool lane_enabled = !full_coverage && (mpl::lane_width(reg_type::lane, clear_mask) != 0);
 
+private:
+  template<access_policy policy>
+  using rmw_tag = typename std::conditional< full_coverage || lane_enabled, no_rmw_tag, std::integral_constant<access_policy, policy> >::type;
+
+public:
+
+  /** True if test() is performed by a bit-band load. */
+  static constexpr bool bitop_test(void) {
+    return reg_type::bitop_enabled && bitband_periph::prefer_bitop_read(bitcount::value);
+  }
+
+  /**
+   * Set register bits: clear bits in clear_mask, set bits in set_mask.
+   *
+   * Depending on policy and the cost model in arch/bitband.hpp, this
+   * results in either a single store() (full_coverage or
+   * set_reset_enabled), a single narrow store (lane_enabled), one
+   * bit-band store per bit, or a read-modify-write.
+   *
+   * access_policy::atomic: the read-modify-write is performed by
+   * reg_type::atomic_set() (exclusive load/store retry loop).
+   */
+  template<access_policy policy = access_policy::fast>
   static __always_inline void set(void) {
-    // TODO: improvement: check for clear_mask covering ALL bits of
-    // our reg_type. if yes, use store() instead!
-#ifndef CONFIG_DISABLE_AUTO_BITBAND_WRITE
-    if(bitop_enabled && (set_mask == clear_mask)) {
-      reg_type::template bitset< bitcount::significant_bits - 1 >();
+    if(full_coverage) {  /* evaluated at compile-time */
+      full_store(set_mask, std::integral_constant<bool, full_coverage>());
+      return;
+    }
+    if(lane_enabled) {  /* evaluated at compile-time */
+      lane_store(set_mask, std::integral_constant<bool, lane_enabled>());
       return;
     }
-#endif
-    if((set_mask != 0) || (clear_mask != 0))  /* evaluated at compile-time */
-      reg_type::set(set_mask, cropped_clear_mask);
+    if(set_reset_enabled) {  /* evaluated at compile-time */
+      set_reset_store(set_mask, cropped_clear_mask, std::integral_constant<bool, set_reset_enabled>());
+      return;
+    }
+    if(bitop_set<policy>()) {  /* evaluated at compile-time */
+      if(set_mask != 0)
+        bitop::set();
+      else
+        bitop::clear();
+      return;
+    }
+    if((set_mask == 0) && (clear_mask == 0))  /* evaluated at compile-time */
+      return;
+    rmw(set_mask, cropped_clear_mask, rmw_tag<policy>());
   }
 
+  /** Clear all bits in clear_mask (see set()). */
+  template<access_policy policy = access_policy::fast>
   static __always_inline void clear(void) {
-#ifndef CONFIG_DISABLE_AUTO_BITBAND_WRITE
-    if(bitop_enabled) {
-      reg_type::template bitclear< bitcount::significant_bits - 1 >();
+    if(full_coverage) {  /* evaluated at compile-time */
+      full_store(0, std::integral_constant<bool, full_coverage>());
+      return;
+    }
+    if(lane_enabled) {  /* evaluated at compile-time */
+      lane_store(0, std::integral_constant<bool, lane_enabled>());
       return;
     }
-#endif
-    if(clear_mask != 0)  /* evaluated at compile-time */
-      reg_type::clear(clear_mask);
+    if(set_reset_enabled) {  /* evaluated at compile-time */
+      set_reset_store(0, clear_mask, std::integral_constant<bool, set_reset_enabled>());
+      return;
+    }
+    if(bitop_clear<policy>()) {  /* evaluated at compile-time */
+      bitop::clear();
+      return;
+    }
+    if(clear_mask == 0)  /* evaluated at compile-time */
+      return;
+    rmw(0, clear_mask, rmw_tag<policy>());
   }
 
   static __always_inline bool test(void) {
     if(clear_mask == 0)
       return false;
-#ifndef CONFIG_DISABLE_AUTO_BITBAND_READ
-    if(bitop_enabled && (set_mask != 0))
+    if(bitop_test() && (set_mask != 0))
       return reg_type::template bittest< bitcount::significant_bits - 1 >();
-    if(bitop_enabled && (set_mask == 0))
+    if(bitop_test() && (set_mask == 0))
       return !reg_type::template bittest< bitcount::significant_bits - 1 >();
-#endif
     if(clear_mask == set_mask)
       return (reg_type::load() & clear_mask);
     return (reg_type::load() & clear_mask) == set_mask;
@@ -210,6 +333,16 @@ class regbits
   regbits() {};
 #endif // CONFIG_USE_STD_TUPLE
 
+  using base_type = regmask< Tp, ((1ul << width) - 1) << offset, ((1ul << width) - 1) << offset >;
+
+  /* single narrow store if the bits cover a lane (see regmask::lane_enabled), read-modify-write otherwise */
+  static __always_inline void set_from_impl(typename Tp::value_type const bits, std::true_type) {
+    base_type::lane_store(bits, std::true_type());
+  }
+  static __always_inline void set_from_impl(typename Tp::value_type const bits, std::false_type) {
+    Tp::reg_type::set(bits, base_type::clear_mask);
+  }
+
  public:
   using type         = regbits<typename Tp::reg_type, offset, width>;
   using reg_type     = typename Tp::reg_type;
@@ -226,7 +359,7 @@ class regbits
   /** NOTE: this does not check if _value is masked correctly! */
   static __always_inline void set_from(value_type const val) {
     // assert((val & (clear_mask >> offset)) == val);  /* input value does not match clear_mask */
-    reg_type::set(value_from(val), regmask_type::clear_mask);
+    set_from_impl(value_from(val), std::integral_constant<bool, regmask_type::lane_enabled>());
   }
   static __always_inline bool test_from(value_type const val) {
     // assert((val & (clear_mask >> offset)) == val);  /* input value does not match clear_mask */
@@ -286,24 +419,110 @@ public:
 };
 
 
+////////////////////  reg_snapshot  ////////////////////
+
+
+/**
+ * Register value from a single load() (see reg::snapshot()), with
+ * accessors for the fields (regbits<>, regval<>, regmask<> types)
+ * of the register. Masks and shifts are resolved at compile-time.
+ *
+ * If Fields... is not empty, only bits covered by the fields in the
+ * list can be accessed (asserted at compile-time).
+ */
+template< typename Tp, typename... Fields >
+class reg_snapshot
+{
+public:
+  using reg_type   = typename Tp::reg_type;
+  using value_type = typename Tp::value_type;
+
+  static_assert(mpl::all_true< std::is_same< typename Fields::reg_type, reg_type >... >::value,
+                "one or more fields (aka: Fields...) are not of reg_type of the snapshot");
+
+  /** Bits accessible from the snapshot */
+  static constexpr value_type covered_mask = (sizeof...(Fields) == 0) ?
+    static_cast<value_type>(~static_cast<value_type>(0)) :
+    merged_regmask< typename reg_type::neutral_regmask, typename Fields::regmask_type... >::clear_mask;
+
+private:
+  value_type const value;
+
+  template<typename Rm>
+  static constexpr value_type checked_mask(void) {
+    static_assert(std::is_same< typename Rm::reg_type, reg_type >::value, "field is not of reg_type of the snapshot");
+    static_assert((Rm::clear_mask & ~covered_mask) == 0, "field is not covered by the snapshot fields");
+    return Rm::clear_mask;
+  }
+
+public:
+  explicit constexpr reg_snapshot(value_type const _value) : value(_value) { }
+
+  /** Returns the raw register value */
+  constexpr value_type raw(void) const {
+    return value;
+  }
+
+  /** Returns the value of a field, shifted to bit 0 (see regbits::load_and_shift()) */
+  template<typename Field>
+  constexpr value_type get(void) const {
+    return (value & checked_mask<Field>()) >> mpl::lowest_bit(Field::clear_mask);
+  }
+
+  /** Returns true if the regmask matches the register value (see regmask::test()) */
+  template<typename Rm>
+  constexpr bool test(void) const {
+    return (Rm::clear_mask == Rm::set_mask) ?
+      ((value & checked_mask<Rm>()) != 0) :
+      ((value & checked_mask<Rm>()) == Rm::set_mask);
+  }
+
+  /** Returns true if ANY of the regmasks matches the register value */
+  template<typename... Rm>
+  constexpr bool test_any(void) const {
+    return any_impl< Rm... >();
+  }
+
+private:
+  template<typename... Rm>
+  constexpr typename std::enable_if< sizeof...(Rm) == 0, bool >::type any_impl(void) const {
+    return false;
+  }
+  template<typename Head, typename... Tail>
+  constexpr bool any_impl(void) const {
+    return test<Head>() || any_impl<Tail...>();
+  }
+};
+
+
 ////////////////////  reg  ////////////////////
 
 
 template<
-  typename   Tp,
-  reg_addr_t addr,
-  reg_perm   permission,
-  Tp         _reset_value = 0 >
+  typename    Tp,
+  reg_addr_t  addr,
+  reg_perm    permission,
+  Tp          _reset_value = 0,
+  reg_barrier barrier = reg_barrier::none,
+  reg_lane    lane    = reg_lane::none >
 class reg
-: public reg_access<Tp, addr, permission, _reset_value>, public typelist_element
+: public reg_access<Tp, addr, permission, _reset_value, barrier, lane>, public typelist_element
 {
 #ifndef CONFIG_USE_STD_TUPLE
   /* private constructor: instantiation would only cause confusion with set/clear functions */
   reg() {};
 #endif // CONFIG_USE_STD_TUPLE
 
+  /* set value masked by clear_mask: single store() on full coverage (register may be write-only) */
+  static __always_inline void set_masked(Tp const value, Tp const, std::true_type) {
+    type::store(value);
+  }
+  static __always_inline void set_masked(Tp const value, Tp const clear_mask, std::false_type) {
+    type::set(value, clear_mask);
+  }
+
 public:
-  using type         = reg<Tp, addr, permission, _reset_value>;
+  using type         = reg<Tp, addr, permission, _reset_value, barrier, lane>;
   using reg_type     = type;
   using regbits_type = regbits< type, 0, sizeof(Tp) * 8>;
   using value_type   = Tp;
@@ -340,6 +559,18 @@ public:
     type::store(reset_value);
   }
 
+  /**
+   * Load the register value once, providing accessors for its fields
+   * (see reg_snapshot). Use this instead of several regmask::test()
+   * or regbits::load_and_shift() calls, each performing a load().
+   *
+   * If Fields... is not empty, access is restricted to these fields.
+   */
+  template<typename... Fields>
+  static __always_inline reg_snapshot< type, Fields... > snapshot(void) {
+    return reg_snapshot< type, Fields... >(type::load());
+  }
+
   template<typename Rm0, typename... Rm>
   struct merge {
     using type = typename mpl::merged_regmask<Rm0, Rm...>::type;
@@ -352,16 +583,47 @@ public:
     merge<Rm0, Rm...>::type::clear();
   }
 
-  /** set constants */
+  /**
+   * clear register bits (or'ed clear_mask of regmask Rm), atomic
+   * against interrupts (see regmask::clear<access_policy::atomic>).
+   */
+  template<typename Rm0, typename... Rm>
+  static __always_inline void atomic_clear(void) {
+    merge<Rm0, Rm...>::type::template clear< access_policy::atomic >();
+  }
+
+  /**
+   * set constants (merged regmask Rm).
+   *
+   * Results in a single store() if the merged clear_mask covers all
+   * register bits (see regmask::full_coverage).
+   */
   template<typename Rm0, typename... Rm>
   static __always_inline void set(void) {
     merge<Rm0, Rm...>::type::set();
   }
 
-  /** set value, masked by clear_mask of regmask (Rm) */
+  using reg_access<Tp, addr, permission, _reset_value, barrier, lane>::atomic_set;
+
+  /**
+   * set constants (merged regmask Rm), atomic against interrupts (see
+   * regmask::set<access_policy::atomic>).
+   */
+  template<typename Rm0, typename... Rm>
+  static __always_inline void atomic_set(void) {
+    merge<Rm0, Rm...>::type::template set< access_policy::atomic >();
+  }
+
+  /**
+   * set value, masked by clear_mask of regmask (Rm).
+   *
+   * Results in a single store() if the merged clear_mask covers all
+   * register bits (see regmask::full_coverage).
+   */
   template<typename Rm0, typename... Rm>
   static __always_inline void set(value_type const value) {
-    set(value, merge<Rm0, Rm...>::type::clear_mask);
+    using merged_type = typename merge<Rm0, Rm...>::type;
+    set_masked(value, merged_type::clear_mask, std::integral_constant<bool, merged_type::full_coverage>());
   }
 
   /** reset register, and set constants (results in single store()) */
@@ -374,6 +636,81 @@ public:
 };
 
 
+////////////////////  reg_pair  ////////////////////
+
+
+/**
+ * Value split into a high (Hi) and a low (Lo) register, e.g. 32bit
+ * counters on 16bit peripherals. The width of the halves is taken
+ * from Hi::regbits_type and Lo::regbits_type.
+ *
+ * load() returns a consistent value, even if the low half wraps
+ * (carrying into the high half) between the two register reads,
+ * using the read_strategy (see reg_pair_read in register_type.hpp).
+ * No interrupts are disabled.
+ *
+ * store() writes the high half first, then the low half.
+ */
+template<
+  typename      Hi,
+  typename      Lo,
+  reg_pair_read read_strategy = reg_pair_read::reread_high,
+  typename      Tp = uint32_t
+  >
+class reg_pair
+{
+  using hi_mask = typename Hi::regbits_type;
+  using lo_mask = typename Lo::regbits_type;
+
+  static_assert((lo_mask::clear_mask & 1) && (hi_mask::clear_mask & 1), "regbits_type of Hi and Lo must start at bit 0");
+
+public:
+  using value_type = Tp;
+
+  static constexpr unsigned lo_width = mpl::bitcount< lo_mask::clear_mask >::significant_bits;
+  static constexpr unsigned hi_width = mpl::bitcount< hi_mask::clear_mask >::significant_bits;
+
+  static_assert(lo_width + hi_width <= sizeof(value_type) * 8, "value_type does not hold Hi and Lo");
+
+  static constexpr value_type compose(typename Hi::value_type const hi, typename Lo::value_type const lo) {
+    return (static_cast<value_type>(hi & hi_mask::clear_mask) << lo_width) |
+      static_cast<value_type>(lo & lo_mask::clear_mask);
+  }
+
+private:
+
+  static __always_inline value_type load_impl(std::integral_constant< reg_pair_read, reg_pair_read::reread_high >) {
+    typename Hi::value_type hi = Hi::load();
+    typename Hi::value_type hi_check;
+    typename Lo::value_type lo;
+    while(true) {
+      lo = Lo::load();
+      hi_check = Hi::load();
+      if((hi_check & hi_mask::clear_mask) == (hi & hi_mask::clear_mask))
+        break;
+      hi = hi_check;  /* low half wrapped: read again */
+    }
+    return compose(hi, lo);
+  }
+
+  static __always_inline value_type load_impl(std::integral_constant< reg_pair_read, reg_pair_read::latched >) {
+    typename Lo::value_type const lo = Lo::load();
+    return compose(Hi::load(), lo);
+  }
+
+public:
+
+  static __always_inline value_type load(void) {
+    return load_impl(std::integral_constant< reg_pair_read, read_strategy >());
+  }
+
+  static __always_inline void store(value_type const value) {
+    Hi::store((value >> lo_width) & hi_mask::clear_mask);
+    Lo::store(value & lo_mask::clear_mask);
+  }
+};
+
+
 ////////////////////  reglist  ////////////////////
 
 
@@ -386,19 +723,54 @@ class reglist
 {
   using type = reglist< Tp... >;
 
-  using merged_list = typename type::template map< mpl::map_merged_regmask >;
-  using unique_merged_list = typename merged_list::filter_unique::type;
+  using merged_lists = mpl::unique_merged_regmask_list< typelist< Tp... > >;
+
+  using unique_merged_list = typename merged_lists::type;
+
+  /**
+   * unique_merged_list, ordered by register write order (see
+   * arch/reg_order.hpp): registers the hardware requires to be
+   * written first (e.g. clock enables), then ascending address.
+   */
+  using ordered_unique_merged_list = typename merged_lists::ordered_type;
+
+  /** Write registers in a loop over constant tables (see mpl::reg_table). */
+  template< write_strategy strategy >
+  static __always_inline void apply_impl(std::true_type) {
+    using table_list = typename ordered_unique_merged_list::template pack< mpl::pack_reg_table_runs< strategy > >::type;
+    table_list::template for_each< mpl::functor_reg_table_apply >();
+  }
+
+  /** Write registers one by one (unrolled). */
+  template< write_strategy strategy >
+  static __always_inline void apply_impl(std::false_type) {
+    ordered_unique_merged_list::template for_each< mpl::functor_reg_write< strategy > >();
+  }
 
 public:
 
   /**
-   * Call ::set() on each distinct merged regmask from reglist.
+   * Returns true if apply<strategy, emission>() writes the registers
+   * using constant tables (see reglist_emission in register_type.hpp).
+   */
+  template< write_strategy strategy, reglist_emission emission = reglist_emission::automatic >
+  static constexpr bool table_emission(void) {
+    return (emission == reglist_emission::table) ||
+      ((emission == reglist_emission::automatic) &&
+       (strategy == write_strategy::reset_to || strategy == write_strategy::blind_store) &&
+       (reglist_table_threshold != 0) &&
+       (ordered_unique_merged_list::size >= reglist_table_threshold));
+  }
+
+  /**
+   * Call ::set() on each distinct merged regmask from reglist, in
+   * register write order (see arch/reg_order.hpp).
    *
    * Refer to the "mpl::functor_reg_set" documentation in
    * register_mpl.hpp for a discussion about reset_to() and set().
    */
   static __always_inline void set(void) {
-    unique_merged_list::template for_each< mpl::functor_reg_set >();
+    apply< write_strategy::rmw >();
   }
 
   /**
@@ -408,19 +780,87 @@ public:
     unique_merged_list::template for_each< mpl::functor_reg_clear >();
   }
 
-#if 0  // TODO: implement 
-  static __always_inline void test(void) {
+  /**
+   * Returns true if ALL regmasks from reglist match the register
+   * values, i.e. (reg_type::load() & clear_mask) == set_mask for
+   * each distinct merged regmask.
+   *
+   * Performs at most one load() per distinct register.
+   *
+   * NOTE: unlike regmask::test(), a multi-bit regmask with set_mask
+   * == clear_mask matches only if ALL its bits are set.
+   */
+  static __always_inline bool test(void) {
+    return unique_merged_list::template pack< mpl::pack_reg_test< typelist< Tp... > > >::type::all();
   }
-#endif
 
   /**
-   * Call ::reset_to() on each distinct merged regmask from reglist.
+   * Returns true if ANY regmask from reglist matches its register
+   * value (see test()).
+   *
+   * Performs at most one load() per distinct register.
+   */
+  static __always_inline bool test_any(void) {
+    return unique_merged_list::template pack< mpl::pack_reg_test< typelist< Tp... > > >::type::any();
+  }
+
+  /**
+   * Call ::reset_to() on each distinct merged regmask from reglist,
+   * in register write order (see arch/reg_order.hpp).
    *
    * Refer to the "mpl::functor_reg_reset_to" documentation in
    * register_mpl.hpp for a discussion about reset_to() and set().
+   *
+   * See apply() for the emission parameter.
    */
+  template< reglist_emission emission = reglist_emission::automatic >
   static __always_inline void reset_to(void) {
-    unique_merged_list::template for_each< mpl::functor_reg_reset_to >();
+    apply< write_strategy::reset_to, emission >();
+  }
+
+  /**
+   * Write each distinct merged regmask from reglist to its register
+   * using the given write strategy (see write_strategy in
+   * register_type.hpp), in register write order (see
+   * arch/reg_order.hpp).
+   *
+   * write_strategy::automatic chooses the strategy per register at
+   * compile-time (see mpl::auto_write_strategy in register_mpl.hpp).
+   *
+   * The emission parameter selects between one store() per register
+   * and a loop over constant tables (see reglist_emission in
+   * register_type.hpp). Table emission is only available for
+   * write_strategy::reset_to and write_strategy::blind_store.
+   */
+  template< write_strategy strategy, reglist_emission emission = reglist_emission::automatic >
+  static __always_inline void apply(void) {
+    static_assert(emission != reglist_emission::table ||
+                  strategy == write_strategy::reset_to || strategy == write_strategy::blind_store,
+                  "table emission requires write_strategy::reset_to or write_strategy::blind_store");
+    apply_impl< strategy >(std::integral_constant< bool, table_emission< strategy, emission >() >());
+  }
+
+  /**
+   * Analog to apply(), asserting all regmasks in reglist to be of
+   * reg_type from any reg in strict_reg_type list.
+   *
+   * For write_strategy::reset_to, also resets regs from
+   * strict_reg_type if no regmask of same reg_type is in reglist
+   * (all other strategies leave these registers untouched).
+   */
+  template< write_strategy strategy, typename... strict_reg_type >
+  static __always_inline void strict_apply(void) {
+    static_assert(reglist< Tp... >::template all_reg_type< strict_reg_type... >::value,
+                  "one or more elements (aka: Tp...) are not of reg_type listed in strict_reg_type");
+
+    /* add neutral regmasks to the list, which enforces these registers to be set in reset_to() call. */
+    using strict_list = typename std::conditional<
+      strategy == write_strategy::reset_to,
+      reglist< typename strict_reg_type::neutral_regmask..., Tp... >,
+      reglist< Tp... >
+      >::type;
+
+    strict_list::template apply< strategy >();
   }
 
   /**
@@ -435,16 +875,7 @@ public:
    */
   template< typename... strict_reg_type >
   static __always_inline void strict_reset_to(void) {
-    static_assert(reglist< Tp... >::template all_reg_type< strict_reg_type... >::value,
-                  "one or more elements (aka: Tp...) are not of reg_type listed in strict_reg_type");
-
-    /* add neutral regmasks to the list, which enforces these registers to be set in reset_to() call. */
-    using strict_list = reglist<
-      typename strict_reg_type::neutral_regmask...,
-      Tp...
-      >;
-
-    strict_list::reset_to();
+    strict_apply< write_strategy::reset_to, strict_reg_type... >();
   }
 
   /**
@@ -458,6 +889,28 @@ public:
     static constexpr bool value = bool_list::all_true::value;
   };
 
+  /**
+   * Compile-time report of the register writes performed by
+   * apply<strategy>() (reset_to() per default), see mpl::reg_report
+   * in register_mpl.hpp:
+   *
+   *   - numof_registers, numof_stores, numof_loads
+   *   - table[]: {addr, value, known_mask} in register write order
+   *   - value(addr), known_mask(addr), contains(addr)
+   *   - dump(): print the table (simulation only)
+   *
+   * Example (startup budget):
+   *
+   *     using report = make_reglist< resources >::report<>;
+   *     static_assert(report::numof_stores <= 24, "startup sequence grew");
+   *     static_assert(report::value(RCC::APB1ENR::addr) == 0x18020000, "apb1enr");
+   *
+   * NOTE: with table emission (see apply()), the stores are performed
+   * in a loop.
+   */
+  template< write_strategy strategy = write_strategy::reset_to >
+  using report = typename ordered_unique_merged_list::template pack< mpl::pack_reg_report< strategy > >::type;
+
   /**
    * Provides a typelist, whose elements are a filtered subset of all
    * reglist<> elements with underlying reg_type = Treg
@@ -484,6 +937,68 @@ public:
 template< typename... Tp >
 using make_reglist = reglist< typename typelist< Tp... >::template filter_type< mpl::regmask_tag > >;
 
+
+////////////////////  reglist_transition  ////////////////////
+
+
+/**
+ * Transition of the registers from configuration From to
+ * configuration To (both reglist<> types), computed at compile-time.
+ *
+ * apply<strategy>() results in the same register values as
+ * To::apply<strategy>(), provided that From::apply<strategy>() was
+ * the last write to the registers: registers having identical values
+ * in From and To are skipped, registers with unknown bits (rmw) are
+ * only modified on the changed bits.
+ *
+ * NOTE: write_strategy::automatic is not supported.
+ */
+template< typename From, typename To >
+class reglist_transition
+{
+  template< write_strategy strategy, typename from_list, typename to_list >
+  using transition_list = make_reglist<
+    typename mpl::unique_merged_regmask_list< to_list >::type
+    ::template map< mpl::map_transition_regmask< strategy, from_list > >
+    >;
+
+public:
+
+  /**
+   * Write all registers which differ between From and To, in
+   * register write order (see arch/reg_order.hpp).
+   */
+  template< write_strategy strategy >
+  static __always_inline void apply(void) {
+    transition_list< strategy, From, To >::template apply< write_strategy::rmw >();
+  }
+
+  /**
+   * Analog to apply(), asserting all regmasks in From and To to be of
+   * reg_type from any reg in strict_reg_type list (see
+   * reglist::strict_apply()).
+   */
+  template< write_strategy strategy, typename... strict_reg_type >
+  static __always_inline void strict_apply(void) {
+    static_assert(From::template all_reg_type< strict_reg_type... >::value &&
+                  To::template all_reg_type< strict_reg_type... >::value,
+                  "one or more elements (aka: Tp...) are not of reg_type listed in strict_reg_type");
+
+    using strict_from = typename std::conditional<
+      strategy == write_strategy::reset_to,
+      reglist< typename strict_reg_type::neutral_regmask..., From >,
+      From
+      >::type;
+    using strict_to = typename std::conditional<
+      strategy == write_strategy::reset_to,
+      reglist< typename strict_reg_type::neutral_regmask..., To >,
+      To
+      >::type;
+
+    transition_list< strategy, strict_from, strict_to >::template apply< write_strategy::rmw >();
+  }
+};
+
 } // namespace mptl
 
 #endif // REGISTER_HPP_INCLUDED
@@ -21,23 +21,156 @@
 #ifndef REGISTER_ACCESS_HPP_INCLUDED
 #define REGISTER_ACCESS_HPP_INCLUDED
 
+#include <type_traits>
 #include <compiler.h>
 #include <register_type.hpp>
 #include <arch/bitband.hpp>
+#include <arch/reg_set_reset.hpp>
 
 #ifdef OPENMPTL_SIMULATION
 #  include <register_sim.hpp>
+#else
+#  include <arch/exclusive.hpp>
+#  include <arch/barrier.hpp>
 #endif
 
 namespace mptl {
 
+////////////////////  reg_shadow  ////////////////////
+
+/**
+ * RAM shadow of a register value, initialized to reset_value.
+ *
+ * Used by reg_access for registers with permission=rw_sw, if
+ * CONFIG_REGISTER_SHADOW is defined: load() returns the shadow
+ * value instead of reading the register, and every write updates
+ * the shadow value.
+ *
+ * NOTE: This assumes that the register holds its reset value on
+ * startup, and that it is never modified by hardware or by
+ * concurrent code (interrupt handlers). Atomic accesses on shadowed
+ * registers are rejected at compile-time.
+ */
+template<typename Tp, reg_addr_t addr, reg_perm permission, Tp reset_value>
+struct reg_shadow
+{
+#ifdef CONFIG_REGISTER_SHADOW
+  static constexpr bool enabled = (permission == rw_sw);
+#else
+  static constexpr bool enabled = false;
+#endif
+
+  using tag = std::integral_constant<bool, enabled>;
+
+  static Tp value;
+
+  static __always_inline void store(Tp const val, std::true_type) {
+    value = val;
+  }
+  static __always_inline void store(Tp const, std::false_type) { }
+
+  static __always_inline void modify(Tp const set_mask, Tp const clear_mask, std::true_type) {
+    value = (value & ~clear_mask) | set_mask;
+  }
+  static __always_inline void modify(Tp const, Tp const, std::false_type) { }
+};
+
+template<typename Tp, reg_addr_t addr, reg_perm permission, Tp reset_value>
+Tp reg_shadow<Tp, addr, permission, reset_value>::value = reset_value;
+
+
+////////////////////  reg_block  ////////////////////
+
+/**
+ * Block of registers, addressed relative to base_addr.
+ *
+ * The base address is passed through an empty asm statement, which
+ * hides its value from the compiler: it is loaded once into a
+ * register (and reused for consecutive accesses), and registers are
+ * accessed using "base register + immediate offset" addressing,
+ * instead of loading every absolute register address from the
+ * literal pool.
+ *
+ * Used by reg_access if CONFIG_REGISTER_BLOCK_ADDRESSING is defined,
+ * grouping all registers into aligned blocks of size bytes (4096:
+ * maximum immediate offset of Thumb-2 LDR/STR instructions).
+ */
+template<reg_addr_t _base_addr>
+struct reg_block
+{
+  static constexpr reg_addr_t size      = 0x1000;
+  static constexpr reg_addr_t base_addr = _base_addr;
+
+  static_assert((base_addr & (size - 1)) == 0, "base_addr is not aligned to reg_block::size");
+
+  /** Returns base_addr, opaque to the compiler. */
+  static __always_inline reg_addr_t base(void) {
+    reg_addr_t value = base_addr;
+    __asm__ ("" : "+r" (value));
+    return value;
+  }
+
+  /** Returns a pointer to the register at offset */
+  template<typename Tp, reg_addr_t offset>
+  static __always_inline volatile Tp * ptr(void) {
+    static_assert(offset < size, "offset out of range");
+    return reinterpret_cast<volatile Tp *>(base() + offset);
+  }
+};
+
+/** Provides the reg_block type (aligned to reg_block::size) holding register address addr */
+template<reg_addr_t addr>
+struct reg_block_of {
+  static constexpr reg_addr_t offset = addr & (reg_block<0>::size - 1);
+  using type = reg_block< addr - offset >;
+};
+
+
+////////////////////  reg_lane  ////////////////////
+
+namespace mpl {
+
+/** Mask of the lane of width bits at bit offset */
+template<typename Tp>
+constexpr Tp lane_mask(unsigned offset, unsigned width) {
+  return static_cast<Tp>(((static_cast<Tp>(1) << width) - 1) << offset);
+}
+
+/** True if a narrow store of width bits at bit offset is supported (see reg_lane) */
+constexpr bool lane_supported(reg_lane lane, unsigned offset, unsigned width) {
+  return ((width == 8 && lane == reg_lane::byte) || (width == 16 && lane != reg_lane::none)) && (offset % width == 0);
+}
+
+/** Position of the lowest bit set in mask (mask must be non-zero) */
+template<typename Tp>
+constexpr unsigned lowest_bit(Tp mask, unsigned pos = 0) {
+  return (mask & 1) ? pos : lowest_bit<Tp>(mask >> 1, pos + 1);
+}
+
+/**
+ * Width of the narrowest lane (8 or 16) supported by lane, which
+ * covers exactly the bits in mask, or 0 if none.
+ */
+template<typename Tp>
+constexpr unsigned lane_width(reg_lane lane, Tp mask) {
+  return ((mask == 0) || (lane == reg_lane::none)) ? 0 :
+    (lane_supported(lane, lowest_bit<Tp>(mask),  8) && (sizeof(Tp) >  1) && (mask == lane_mask<Tp>(lowest_bit<Tp>(mask),  8))) ?  8 :
+    (lane_supported(lane, lowest_bit<Tp>(mask), 16) && (sizeof(Tp) >  2) && (mask == lane_mask<Tp>(lowest_bit<Tp>(mask), 16))) ? 16 :
+    0;
+}
+
+} // namespace mpl
+
+
 #ifndef OPENMPTL_SIMULATION
 
 template<
-  typename   Tp,
-  reg_addr_t _addr,
-  reg_perm   _permission,
-  Tp         reset_value
+  typename    Tp,
+  reg_addr_t  _addr,
+  reg_perm    _permission,
+  Tp          reset_value,
+  reg_barrier _barrier = reg_barrier::none,
+  reg_lane    _lane    = reg_lane::none
   >
 struct reg_access
 {
@@ -48,35 +181,111 @@ struct reg_access
   /** Integral type used for register access. */
   using value_type = Tp;
 
-  static constexpr reg_addr_t addr       = _addr;
-  static constexpr reg_perm   permission = _permission;
+  static constexpr reg_addr_t  addr       = _addr;
+  static constexpr reg_perm    permission = _permission;
+  static constexpr reg_barrier barrier    = _barrier;
+  static constexpr reg_lane    lane       = _lane;
+
+private:
+  using shadow = reg_shadow<Tp, addr, permission, reset_value>;
+
+  static __always_inline volatile Tp * reg_ptr(void) {
+#ifdef CONFIG_REGISTER_BLOCK_ADDRESSING
+    return reg_block_of<addr>::type::template ptr<Tp, reg_block_of<addr>::offset>();
+#else
+    return reinterpret_cast<volatile Tp *>(addr);
+#endif
+  }
+
+  static __always_inline Tp load_impl(std::false_type) {
+    return *reg_ptr();
+  }
+  static __always_inline Tp load_impl(std::true_type) {
+    return shadow::value;
+  }
 
-  static constexpr bool bitop_enabled = bitband_periph::covered(addr);
+public:
+  /** True if load() is served from a RAM shadow (see reg_shadow). */
+  static constexpr bool shadowed = shadow::enabled;
+
+  static constexpr bool bitop_enabled = bitband_periph::covered(addr) && !shadowed;
+
+  /** True if bits may be written by bit-band stores (not on write-to-clear flag registers). */
+  static constexpr bool bitop_write_enabled = bitop_enabled && (permission != rw_wc);
 
   /** Load (read) register value. */
   static __always_inline Tp load(void) {
     static_assert(permission != wo, "read access to a write-only register");
-    return *reinterpret_cast<volatile Tp *>(addr);
+    return load_impl(typename shadow::tag());
   }
 
-  /** Store (write) a register value. */
+  /** Store (write) a register value, followed by barrier (if any). */
   static __always_inline void store(Tp const value) {
     static_assert(permission != ro, "write access to a read-only register");
-    *reinterpret_cast<volatile Tp *>(addr) = value;
+    shadow::store(value, typename shadow::tag());
+    *reg_ptr() = value;
+    memory_barrier::after_store<barrier>();
+  }
+
+  /**
+   * Notify a store of value performed by other means than store()
+   * (e.g. register tables, see mpl::reg_table). Updates the shadow
+   * register, no register access.
+   */
+  static __always_inline void stored(Tp const value) {
+    shadow::store(value, typename shadow::tag());
+  }
+
+  /**
+   * Store the bits of value within the lane of width bits at bit
+   * offset, using a single narrow store (strb/strh) at
+   * addr + offset / 8. All other bits of the register are left
+   * untouched (no read).
+   */
+  template<unsigned offset, unsigned width>
+  static __always_inline void lane_store(Tp const value) {
+    static_assert(permission != ro, "write access to a read-only register");
+    static_assert(mpl::lane_supported(lane, offset, width), "narrow store not supported by register (see reg_lane)");
+    using lane_type = typename std::conditional< width == 8, uint8_t, uint16_t >::type;
+    constexpr Tp mask = mpl::lane_mask<Tp>(offset, width);
+    shadow::modify(value & mask, mask, typename shadow::tag());
+    *(reinterpret_cast<volatile lane_type *>(reg_ptr()) + offset / width) = static_cast<lane_type>(value >> offset);
+    memory_barrier::after_store<barrier>();
+  }
+
+  /**
+   * Atomic read-modify-write: clear bits in clear_mask and set bits
+   * in set_mask, using an exclusive load/store retry loop. Safe
+   * against concurrent modification from interrupt handlers.
+   */
+  static __always_inline void atomic_set(Tp const set_mask, Tp const clear_mask) {
+    static_assert(permission != wo, "read access to a write-only register");
+    static_assert(permission != ro, "write access to a read-only register");
+    static_assert(!shadowed, "atomic access on a shadowed register");
+    volatile Tp * const value_ptr = reg_ptr();
+    Tp value;
+    do {
+      value = exclusive_access::load(value_ptr);
+    } while(!exclusive_access::store(value_ptr, static_cast<Tp>((value & ~clear_mask) | set_mask)));
+    memory_barrier::after_store<barrier>();
   }
 
   /** Set a single bit using bitband_periph::bitset<> */
   template<unsigned bit_no>
   static __always_inline void bitset() {
     static_assert(permission != ro, "write access to a read-only register");
+    shadow::modify(static_cast<Tp>(1) << bit_no, 0, typename shadow::tag());
     bitband_periph::bitset<addr, bit_no>();
+    memory_barrier::after_store<barrier>();
   }
 
   /** Clear a single bit using bitband_periph::bitclear<> */
   template<unsigned bit_no>
   static __always_inline void bitclear() {
     static_assert(permission != ro, "write access to a read-only register");
+    shadow::modify(0, static_cast<Tp>(1) << bit_no, typename shadow::tag());
     bitband_periph::bitclear<addr, bit_no>();
+    memory_barrier::after_store<barrier>();
   }
 
   /** Returns the value of a single bit using bitband_periph::bittest<> */
@@ -92,20 +301,59 @@ struct reg_access
 
 
 template<
-  typename   Tp,
-  reg_addr_t _addr,
-  reg_perm   _permission,
-  Tp         reset_value
+  typename    Tp,
+  reg_addr_t  _addr,
+  reg_perm    _permission,
+  Tp          reset_value,
+  reg_barrier _barrier = reg_barrier::none,
+  reg_lane    _lane    = reg_lane::none
   >
 class reg_access
 {
-  static void store_impl(Tp const value) {
+  using shadow = reg_shadow<Tp, _addr, _permission, reset_value>;
+
+  static Tp load_impl(std::false_type) {
+#ifdef CONFIG_DUMP_REGISTER_ACCESS
+    dumper::dump_register_load(reg_value);
+#endif // CONFIG_DUMP_REGISTER_ACCESS
+    return reg_value;
+  }
+
+  /* served from shadow: no register access, nothing to dump */
+  static Tp load_impl(std::true_type) {
+    return shadow::value;
+  }
+
+  /* set/reset register: set and reset bits of the output register (see arch/reg_set_reset.hpp) */
+  static void set_reset_impl(Tp const value, std::true_type) {
+    using output = reg_set_reset::output_type< reg_set_reset::output_addr(_addr) >;
+    static_assert(std::is_same<typename output::type, typename output::reg_type>::value &&
+                  (output::addr == reg_set_reset::output_addr(_addr)),
+                  "output register of set/reset register is not declared (see arch/reg_set_reset.hpp)");
+    constexpr Tp mask = (static_cast<Tp>(1) << reg_set_reset::width) - 1;
+    output::reg_value = (output::reg_value & ~((value >> reg_set_reset::width) & mask)) | (value & mask);
+  }
+  static void set_reset_impl(Tp const, std::false_type) { }
+
+  /* barrier after write access: no-op, dumped for annotated registers */
+  static void barrier_impl(void) {
+#ifdef CONFIG_DUMP_REGISTER_ACCESS
+    if(_barrier != reg_barrier::none)
+      dumper::dump_register_barrier(reg_value, _barrier);
+#endif
+  }
+
+  /* written: bits actually written by the store (differs from value for lane stores) */
+  static void store_impl(Tp const value, Tp const written) {
     static_assert(permission != ro, "write access to a read-only register");
 
+    shadow::store(value, typename shadow::tag());
 #ifdef CONFIG_REGISTER_REACTION
     sim::reg_reaction reaction(addr, reg_value);
 #endif
     reg_value = value;
+    set_reset_impl(written, std::integral_constant<bool, reg_set_reset::set_reset(_addr)>());
+    barrier_impl();
 #ifdef CONFIG_REGISTER_REACTION
     sim::regdump_reaction_running++;
     reaction.react();
@@ -117,10 +365,18 @@ public:
   using value_type = Tp;
   static Tp reg_value;
 
-  static constexpr reg_addr_t addr       = _addr;
-  static constexpr reg_perm   permission = _permission;
+  static constexpr reg_addr_t  addr       = _addr;
+  static constexpr reg_perm    permission = _permission;
+  static constexpr reg_barrier barrier    = _barrier;
+  static constexpr reg_lane    lane       = _lane;
+
+  /** True if load() is served from a RAM shadow (see reg_shadow). */
+  static constexpr bool shadowed = shadow::enabled;
 
-  static constexpr bool bitop_enabled = bitband_periph::covered(addr);
+  static constexpr bool bitop_enabled = bitband_periph::covered(addr) && !shadowed;
+
+  /** True if bits may be written by bit-band stores (not on write-to-clear flag registers). */
+  static constexpr bool bitop_write_enabled = bitop_enabled && (permission != rw_wc);
 
 #ifdef CONFIG_DUMP_REGISTER_ACCESS
   using dumper = sim::reg_dumper<Tp, addr>;
@@ -128,41 +384,79 @@ public:
 
   static Tp load() {
     static_assert(permission != wo, "read access to a write-only register");
-#ifdef CONFIG_DUMP_REGISTER_ACCESS
-    dumper::dump_register_load(reg_value);
-#endif // CONFIG_DUMP_REGISTER_ACCESS
-    return reg_value;
+    return load_impl(typename shadow::tag());
   }
 
   static void store(Tp const value) {
 #ifdef CONFIG_DUMP_REGISTER_ACCESS
     dumper::dump_register_store(reg_value, value);
 #endif
-    store_impl(value);
+    store_impl(value, value);
+  }
+
+  /**
+   * Narrow store (see embedded reg_access): updates the bits of the
+   * lane in reg_value only.
+   */
+  template<unsigned offset, unsigned width>
+  static void lane_store(Tp const value) {
+    static_assert(mpl::lane_supported(_lane, offset, width), "narrow store not supported by register (see reg_lane)");
+    constexpr Tp mask = mpl::lane_mask<Tp>(offset, width);
+    Tp const written = value & mask;
+#ifdef CONFIG_DUMP_REGISTER_ACCESS
+    dumper::dump_register_lane_store(reg_value, written, mask, width);
+#endif
+    store_impl((reg_value & ~mask) | written, written);
+  }
+
+  /**
+   * Atomic read-modify-write (see embedded reg_access), using an
+   * atomic compare-exchange on reg_value.
+   */
+  static void atomic_set(Tp const set_mask, Tp const clear_mask) {
+    static_assert(permission != wo, "read access to a write-only register");
+    static_assert(permission != ro, "write access to a read-only register");
+    static_assert(!shadowed, "atomic access on a shadowed register");
+    Tp old_value = __atomic_load_n(&reg_value, __ATOMIC_SEQ_CST);
+    Tp value;
+    do {
+      value = (old_value & ~clear_mask) | set_mask;
+    } while(!__atomic_compare_exchange_n(&reg_value, &old_value, value, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST));
+
+#ifdef CONFIG_DUMP_REGISTER_ACCESS
+    dumper::dump_register_atomic_set(old_value, value);
+#endif
+    barrier_impl();
+#ifdef CONFIG_REGISTER_REACTION
+    sim::reg_reaction reaction(addr, old_value);
+    sim::regdump_reaction_running++;
+    reaction.react();
+    sim::regdump_reaction_running--;
+#endif
   }
 
   template<unsigned bit_no>
   static __always_inline void bitset() {
-    value_type value = reg_value | (1 << bit_no);
+    value_type value = reg_value | (static_cast<value_type>(1) << bit_no);
 #ifdef CONFIG_DUMP_REGISTER_ACCESS
     dumper::dump_register_bitset(reg_value, bit_no);
 #endif
-    store_impl(value);
+    store_impl(value, value);
   }
 
   template<unsigned bit_no>
   static __always_inline void bitclear() {
-    value_type value = reg_value & ~(1 << bit_no);
+    value_type value = reg_value & ~(static_cast<value_type>(1) << bit_no);
 #ifdef CONFIG_DUMP_REGISTER_ACCESS
     dumper::dump_register_bitclear(reg_value, bit_no);
 #endif
-    store_impl(value);
+    store_impl(value, value);
   }
 
   template<unsigned bit_no>
   static __always_inline bool bittest() {
     static_assert(permission != wo, "read access to a write-only register");
-    value_type value = reg_value & (1 << bit_no);
+    value_type value = reg_value & (static_cast<value_type>(1) << bit_no);
 #ifdef CONFIG_DUMP_REGISTER_ACCESS
     dumper::dump_register_bittest(reg_value, bit_no);
 #endif
@@ -172,12 +466,14 @@ public:
 
 /* initialize reg_value to the reset value */
 template<
-  typename   Tp,
-  reg_addr_t addr,
-  reg_perm   permission,
-  Tp         reset_value
+  typename    Tp,
+  reg_addr_t  addr,
+  reg_perm    permission,
+  Tp          reset_value,
+  reg_barrier barrier,
+  reg_lane    lane
   >
-Tp reg_access<Tp, addr, permission, reset_value>::reg_value = reset_value;
+Tp reg_access<Tp, addr, permission, reset_value, barrier, lane>::reg_value = reset_value;
 
 #endif // OPENMPTL_SIMULATION
 
@@ -0,0 +1,179 @@
+/*
+ * OpenMPTL - C++ Microprocessor Template Library
+ *
+ * Copyright (C) 2012-2017 Axel Burri <axel@tty0.ch>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef REGISTER_ARRAY_HPP_INCLUDED
+#define REGISTER_ARRAY_HPP_INCLUDED
+
+/*
+ * Runtime-indexed register arrays.
+ *
+ * Example (enable interrupt, irqn known at runtime only):
+ *
+ *     using ISER = reg_array< NVIC::ISER<0>, 4, 8 >;
+ *     ISER::store(irqn >> 5, 1 << (irqn & 0x1f));
+ */
+
+#include <cstddef>
+#include <compiler.h>
+#include <register.hpp>
+
+#ifdef OPENMPTL_SIMULATION
+#  include <cassert>
+#  define CONFIG_REG_ARRAY_BOUNDS_CHECK  /* always checked in simulation */
+#endif
+
+namespace mptl {
+
+/**
+ * Array of N registers of same type, stride bytes apart, starting at
+ * register Reg (first element, reg<> type). The registers are
+ * accessed by index at runtime, using a single load/store on the
+ * computed address (base address + index * stride), instead of
+ * selecting a reg<> instantiation by index (switch).
+ *
+ * All elements have the permission, reset value, barrier and lane
+ * (see reg_lane) of Reg. The element types are available as
+ * element<index>: they are of same reg<> type as the registers
+ * declared in arch/reg/ (e.g. NVIC::ISER<3>, GPIO<'C'>::BSRR),
+ * sharing register state in simulation.
+ *
+ * CONFIG_REG_ARRAY_BOUNDS_CHECK: check index against N on every
+ * access (always enabled in simulation). An out-of-bounds index
+ * asserts in simulation, and traps (undefined instruction, resulting
+ * in a HardFault) on the target.
+ */
+template<typename Reg, reg_addr_t _stride, std::size_t N>
+class reg_array
+{
+  static_assert(std::is_same<typename Reg::type, typename Reg::reg_type>::value, "template argument Reg is not of type: reg<>");
+  static_assert(N >= 1, "reg_array requires at least one element");
+  static_assert(_stride >= sizeof(typename Reg::value_type), "stride is smaller than the register size");
+  static_assert((_stride % sizeof(typename Reg::value_type)) == 0, "stride is not aligned to the register size");
+  static_assert(!Reg::shadowed, "runtime-indexed access on a shadowed register");
+
+public:
+  using reg_type   = typename Reg::reg_type;
+  using value_type = typename Reg::value_type;
+
+  static constexpr reg_addr_t  base_addr  = Reg::addr;
+  static constexpr reg_addr_t  stride     = _stride;
+  static constexpr std::size_t size       = N;
+  static constexpr reg_perm    permission = Reg::permission;
+
+  /** reg<> type of element at index (compile-time) */
+  template<std::size_t index>
+  using element = reg< value_type, base_addr + index * stride, permission, Reg::reset_value, Reg::barrier, Reg::lane >;
+
+  /** Register address of element at index */
+  static constexpr reg_addr_t addr(std::size_t index) {
+    return base_addr + index * stride;
+  }
+
+private:
+
+  static __always_inline void bounds_check(std::size_t const index) {
+#ifdef CONFIG_REG_ARRAY_BOUNDS_CHECK
+#  ifdef OPENMPTL_SIMULATION
+    assert(index < size);  /* reg_array: index out of bounds */
+#  else
+    if(index >= size)
+      __builtin_trap();
+#  endif
+#else
+    (void)index;
+#endif
+  }
+
+#ifdef OPENMPTL_SIMULATION
+
+  using load_func  = value_type (*)(void);
+  using store_func = void (*)(value_type);
+
+  /* per-element reg_access functions: register dump and reactions */
+  template<std::size_t... I>
+  static value_type load_impl(std::size_t const index, mpl::index_sequence<I...>) {
+    static constexpr load_func table[] = { &element<I>::load... };
+    return table[index]();
+  }
+  template<std::size_t... I>
+  static void store_impl(std::size_t const index, value_type const value, mpl::index_sequence<I...>) {
+    static constexpr store_func table[] = { &element<I>::store... };
+    table[index](value);
+  }
+
+  static value_type load_impl(std::size_t const index) {
+    return load_impl(index, mpl::make_index_sequence<N>());
+  }
+  static void store_impl(std::size_t const index, value_type const value) {
+    store_impl(index, value, mpl::make_index_sequence<N>());
+  }
+
+#else
+
+  static __always_inline volatile value_type * reg_ptr(std::size_t const index) {
+    return reinterpret_cast<volatile value_type *>(addr(index));
+  }
+
+  static __always_inline value_type load_impl(std::size_t const index) {
+    return *reg_ptr(index);
+  }
+  static __always_inline void store_impl(std::size_t const index, value_type const value) {
+    *reg_ptr(index) = value;
+    memory_barrier::after_store<Reg::barrier>();
+  }
+
+#endif // OPENMPTL_SIMULATION
+
+public:
+
+  /** Load (read) register value of element at index. */
+  static __always_inline value_type load(std::size_t const index) {
+    static_assert(permission != wo, "read access to a write-only register");
+    bounds_check(index);
+    return load_impl(index);
+  }
+
+  /** Store (write) register value of element at index. */
+  static __always_inline void store(std::size_t const index, value_type const value) {
+    static_assert(permission != ro, "write access to a read-only register");
+    bounds_check(index);
+    store_impl(index, value);
+  }
+
+  static __always_inline value_type test(std::size_t const index, value_type const value) {
+    return load(index) & value;
+  }
+  static __always_inline void set(std::size_t const index, value_type const value) {
+    store(index, load(index) | value);
+  }
+  static __always_inline void set(std::size_t const index, value_type const set_mask, value_type const clear_mask) {
+    store(index, (load(index) & ~clear_mask) | set_mask);
+  }
+  static __always_inline void clear(std::size_t const index, value_type const value) {
+    store(index, load(index) & ~value);
+  }
+  static __always_inline void reset(std::size_t const index) {
+    store(index, Reg::reset_value);
+  }
+};
+
+} // namespace mptl
+
+#endif // REGISTER_ARRAY_HPP_INCLUDED
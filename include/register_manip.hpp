@@ -18,66 +18,141 @@
  *
  */
 
-// TODO: implement make_reg<> class, analog to
-// std::make_tuple<>. This way we can put them into a std::tuple<>
-// class and perform the merge as instances
-//
-// ^^^ allows to mix compile-time traits with reg_manip<> types !
-
-
 #ifndef REGISTER_MANIP_HPP_INCLUDED
 #define REGISTER_MANIP_HPP_INCLUDED
 
-#warning "This is experimental code!"
-
+#include <register.hpp>
 #include <compiler.h>
 
 namespace mptl {
-namespace experimental {
 
-// TODO: rename reg<>
-template<typename T>
-class reg_manip
+
+////////////////////  reg_transaction  ////////////////////
+
+
+/**
+ * Batched read-modify-write of a register, operating on a local copy
+ * of the register value.
+ *
+ * A transaction is started by either load() (single register read),
+ * reset() (register reset value, no read) or from() (any value), and
+ * finished by a single store(). In between, compile-time regmask<>
+ * traits can be mixed with runtime values. All compile-time traits
+ * are merged into constant masks.
+ *
+ * Example:
+ *
+ *     auto cr1 = reg_transaction< USARTx::CR1 >::load();
+ *     if(rxne) cr1.set< USARTx::CR1::RXNEIE >();
+ *     cr1.clear< USARTx::CR1::TCIE, USARTx::CR1::IDLEIE >();
+ *     cr1.store();
+ *
+ * Write-only registers must be started from reset():
+ *
+ *     auto bsrr = reg_transaction< GPIOx::BSRR >::reset();
+ *
+ * NOTE: Permission checks are performed at compile-time, analog to
+ * reg<>: load() asserts on write-only registers, store() asserts on
+ * read-only registers.
+ */
+template<typename R>
+class reg_transaction
 {
 public:
-  using value_type = typename T::value_type;
+  using type       = reg_transaction< R >;
+  using reg_type   = typename R::reg_type;
+  using value_type = typename reg_type::value_type;
 
-  // TODO: wrong. only construct from known regmask<> traits, or
-  // set/clear mask tuple. NEVER do load() magic in constructors!
-  reg_manip() : reg(T::load()) { }
-  reg_manip(value_type val) : reg(val) { }
+  static_assert(std::is_same<typename reg_type::type, reg_type>::value, "template argument R is not of type: reg<>");
 
-  reg_manip<T> operator|(const T & rhs) { return reg_manip<T>(reg | rhs); }
+private:
+  value_type value;
 
-  reg_manip<T> & operator=(const reg_manip<T> &) { return *this; }
-  reg_manip<T> & operator|=(value_type rhs) { this->reg |= rhs; return *this; }
-  reg_manip<T> & operator&=(value_type rhs) { this->reg &= rhs; return *this; }
+  /* private constructor: use load(), reset() or from() */
+  constexpr explicit reg_transaction(value_type const val) : value(val) { }
 
-  constexpr operator value_type() { return reg; }
+public:
 
-  void __always_inline load(void) { reg = T::load(); }
-  void __always_inline store(void) const { T::store(reg); }
+  /** Start transaction from current register value (single load()). */
+  static __always_inline type load(void) {
+    static_assert(reg_type::permission != wo, "read access to a write-only register");
+    return type(reg_type::load());
+  }
 
-  void __always_inline set(value_type const set_mask) { reg |= set_mask; }
-  void __always_inline set(value_type const set_mask, value_type const clear_mask) { reg = (reg & ~clear_mask) | set_mask; }
-  void __always_inline clear(value_type const value) { reg &= ~value; }
+  /** Start transaction from register reset value (no load()). */
+  static constexpr type reset(void) {
+    return type(reg_type::reset_value);
+  }
 
-  template<typename... Rm>
-  void __always_inline clear(void) {
-    clear(T::template merge<Rm...>::type::clear_mask);
+  /** Start transaction from a given value (no load()). */
+  static constexpr type from(value_type const val) {
+    return type(val);
   }
 
-  template<typename... Rm>
-  void __always_inline set(void) {
-    using merged_type = typename T::template merge<Rm...>::type;
-    set( merged_type::set_mask, merged_type::cropped_clear_mask );
+  /** Finish transaction: write local copy to register (single store()). */
+  __always_inline void store(void) const {
+    static_assert(reg_type::permission != ro, "write access to a read-only register");
+    reg_type::store(value);
   }
 
-private:
-  value_type reg;
+  /** Returns the local copy of the register value. */
+  constexpr value_type get(void) const {
+    return value;
+  }
+
+  __always_inline type & set(value_type const set_mask) {
+    value |= set_mask;
+    return *this;
+  }
+  __always_inline type & set(value_type const set_mask, value_type const clear_mask) {
+    value = (value & ~clear_mask) | set_mask;
+    return *this;
+  }
+  __always_inline type & clear(value_type const clear_mask) {
+    value &= ~clear_mask;
+    return *this;
+  }
+
+  /** set constants (merged set/clear mask of regmask Rm) */
+  template<typename Rm0, typename... Rm>
+  __always_inline type & set(void) {
+    using merged_type = typename reg_type::template merge< Rm0, Rm... >::type;
+    return set(merged_type::set_mask, merged_type::cropped_clear_mask);
+  }
+
+  /** set value, masked by merged clear_mask of regmask Rm */
+  template<typename Rm0, typename... Rm>
+  __always_inline type & set(value_type const val) {
+    using merged_type = typename reg_type::template merge< Rm0, Rm... >::type;
+    return set(val, merged_type::clear_mask);
+  }
+
+  /** clear bits (merged clear_mask of regmask Rm) */
+  template<typename Rm0, typename... Rm>
+  __always_inline type & clear(void) {
+    using merged_type = typename reg_type::template merge< Rm0, Rm... >::type;
+    return clear(merged_type::clear_mask);
+  }
+
+  /**
+   * Set regbits<> Rb to val (shifted by offset of Rb).
+   *
+   * NOTE: this does not check if val is masked correctly!
+   */
+  template<typename Rb>
+  __always_inline type & set_from(value_type const val) {
+    static_assert(std::is_same<typename Rb::reg_type, reg_type>::value, "template argument is not of same reg<> type");
+    return set(Rb::value_from(val), Rb::regmask_type::clear_mask);
+  }
+
+  /** test local copy against merged set/clear mask of regmask Rm */
+  template<typename Rm0, typename... Rm>
+  constexpr bool test(void) const {
+    using merged_type = typename reg_type::template merge< Rm0, Rm... >::type;
+    return (value & merged_type::clear_mask) == merged_type::set_mask;
+  }
 };
 
-} // namespace experimental
 } // namespace mptl
 
 #endif // REGISTER_MANIP_HPP_INCLUDED
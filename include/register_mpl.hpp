@@ -24,9 +24,21 @@
 #include <type_traits>
 #include <cstdint>
 #include <typelist.hpp>
+#include <register_type.hpp>
+#include <register_access.hpp>  // mpl::lowest_bit
+#include <arch/reg_order.hpp>
 #include <compiler.h>
 
-namespace mptl { namespace mpl {
+#ifdef OPENMPTL_SIMULATION
+#  include <register_sim.hpp>
+#endif
+
+namespace mptl {
+
+template<typename Tp, typename Tp::value_type set_mask, typename Tp::value_type clear_mask>
+class regmask;
+
+namespace mpl {
 
 /**
  * Base class for regmask<> template. Used for filtering in typelist<>.
@@ -103,6 +115,31 @@ struct map_merged_regmask {
 };
 
 
+/**
+ * Map each element in list to its reg_type.
+ */
+struct map_reg_type {
+  template<typename Tp, typename list_type>
+  struct map {
+    using type = typename Tp::reg_type;
+  };
+};
+
+
+/**
+ * Map each element (reg<> type) in list to a merged_regmask of all
+ * elements in regmask_list having this reg_type.
+ */
+template<typename regmask_list>
+struct map_reg_type_merged_regmask {
+  template<typename Treg, typename list_type>
+  struct map {
+    using filtered_list = typename regmask_list::template filter< filter_reg_type<Treg> >::type;
+    using type = typename filtered_list::template pack< pack_merged_regmask >::type;
+  };
+};
+
+
 /**
  * Map each element (aka: Tp) in list to a
  * std::integral_constant<bool,v> type, with v=true if the Treg
@@ -123,6 +160,341 @@ struct map_contains_reg_type {
 };
 
 
+/**
+ * order_type for sort_list: reg_order::less() on the reg_type::addr
+ * of the elements.
+ */
+struct reg_addr_order {
+  template<typename T>
+  using key = std::integral_constant< reg_addr_t, T::reg_type::addr >;
+
+  static constexpr bool less(std::intmax_t a, std::intmax_t b) {
+    return reg_order::less(static_cast<reg_addr_t>(a), static_cast<reg_addr_t>(b));
+  }
+};
+
+
+/**
+ * Packs elements to a list ordered by reg_order::less() (see
+ * arch/reg_order.hpp).
+ */
+struct pack_reg_ordered_list {
+  template<typename... Tp>
+  struct pack {
+    using type = typename sort_list< reg_addr_order, Tp... >::type;
+  };
+};
+
+
+#ifndef CONFIG_REGLIST_CONSTEXPR_MERGE
+
+/**
+ * Provides lists of merged regmasks, one for each distinct reg_type
+ * of the elements in list_type:
+ *
+ *   - type         : ordered by first occurrence
+ *   - ordered_type : ordered by reg_order::less() (see
+ *                    pack_reg_ordered_list)
+ *
+ * Same as "list_type::map< map_merged_regmask >::filter_unique", but
+ * filters list_type once per distinct register instead of once per
+ * element.
+ *
+ * NOTE: if CONFIG_REGLIST_CONSTEXPR_MERGE is defined, the merged
+ * regmasks are computed by constexpr functions instead (see
+ * constexpr_merged_regmask_list below).
+ */
+template<typename list_type>
+struct unique_merged_regmask_list {
+  using reg_list = typename list_type::template map< map_reg_type >::filter_unique;
+  using type = typename reg_list::template map< map_reg_type_merged_regmask< list_type > >;
+  using ordered_type = typename type::template pack< pack_reg_ordered_list >::type;
+};
+
+#else // CONFIG_REGLIST_CONSTEXPR_MERGE
+
+#if __cplusplus < 201402L
+#  error "CONFIG_REGLIST_CONSTEXPR_MERGE requires C++14 (relaxed constexpr)"
+#endif
+
+/**
+ * Register address, size and set/clear masks of a regmask<>.
+ */
+struct regmask_value {
+  reg_addr_t     addr;
+  std::size_t    width;  /* sizeof(value_type) */
+  std::uintmax_t set_mask;
+  std::uintmax_t clear_mask;
+};
+
+enum class regmask_merge_error {
+  none,
+  set_cleared,   /**< setting a bit which was previously cleared */
+  clear_set,     /**< clearing a bit which was previously set    */
+  width          /**< registers of different size at same address */
+};
+
+/**
+ * Result of merge_regmask_values(), for size elements:
+ *
+ *   - first[i]    : index of the first element having the register
+ *                   of element i
+ *   - count[i]    : number of elements having the register of
+ *                   element i (valid if first[i] == i)
+ *   - merged[i]   : merged masks of all elements having the register
+ *                   of element i (valid if first[i] == i)
+ *   - ordered[k]  : index of the first element of the k-th distinct
+ *                   register, ordered by reg_order::less() (stable)
+ *   - distinct    : number of distinct registers
+ */
+template<std::size_t size>
+struct regmask_merge_result {
+  std::size_t         first[size + 1];
+  std::size_t         count[size + 1];
+  regmask_value       merged[size + 1];
+  std::size_t         ordered[size + 1];
+  std::size_t         distinct;
+  regmask_merge_error error;
+};
+
+/**
+ * Merge the regmask values (in list order), and order the distinct
+ * registers by reg_order::less() on their address.
+ *
+ * Evaluated at compile-time, without any template instantiation
+ * per element.
+ */
+template<std::size_t size>
+constexpr regmask_merge_result<size> merge_regmask_values(regmask_value const (&values)[size + 1])
+{
+  regmask_merge_result<size> r {};
+  r.error = regmask_merge_error::none;
+
+  for(std::size_t i = 0; i < size; i++) {
+    /* binary search in the ordered distinct registers */
+    std::size_t lo = 0;
+    std::size_t hi = r.distinct;
+    while(lo < hi) {
+      std::size_t mid = lo + (hi - lo) / 2;
+      if(reg_order::less(r.merged[r.ordered[mid]].addr, values[i].addr))
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+
+    if((lo == r.distinct) || (r.merged[r.ordered[lo]].addr != values[i].addr)) {
+      /* new register: insert at lo */
+      for(std::size_t k = r.distinct; k > lo; k--)
+        r.ordered[k] = r.ordered[k - 1];
+      r.ordered[lo] = i;
+      r.distinct++;
+      r.first[i] = i;
+      r.count[i] = 1;
+      r.merged[i] = values[i];
+      continue;
+    }
+
+    std::size_t f = r.ordered[lo];
+    r.first[i] = f;
+    r.count[f]++;
+
+    regmask_value & m = r.merged[f];
+    regmask_value const & v = values[i];
+    if(r.error == regmask_merge_error::none) {
+      /* same checks as regmask::merge<> */
+      if(m.width != v.width)
+        r.error = regmask_merge_error::width;
+      else if((v.set_mask & m.clear_mask) & ~m.set_mask)
+        r.error = regmask_merge_error::set_cleared;
+      else if((m.set_mask & v.clear_mask) & ~v.set_mask)
+        r.error = regmask_merge_error::clear_set;
+    }
+    m.set_mask   |= v.set_mask;
+    m.clear_mask |= v.clear_mask;
+  }
+  return r;
+}
+
+/**
+ * Value based implementation of unique_merged_regmask_list (see
+ * above).
+ *
+ * The set/clear masks of all elements are collected in a constexpr
+ * array and merged by merge_regmask_values(), instead of building a
+ * chain of intermediate regmask<> types per element. Only the
+ * resulting merged regmask<> types are instantiated (one per
+ * distinct register), resulting in the same register accesses.
+ *
+ * NOTE: registers are identified by their address: all elements
+ * having the same register address must be of same reg_type.
+ */
+template<typename list_type>
+struct constexpr_merged_regmask_list;
+
+template<typename... Tp>
+struct constexpr_merged_regmask_list< sane_typelist< Tp... > >
+{
+  static constexpr std::size_t size = sizeof...(Tp);
+
+  static constexpr regmask_value values[size + 1] = {
+    { Tp::reg_type::addr, sizeof(typename Tp::value_type), Tp::set_mask, Tp::clear_mask }...,
+    { 0, 0, 0, 0 }
+  };
+
+  using result_type = regmask_merge_result<size>;
+  static constexpr result_type result = merge_regmask_values<size>(values);
+
+  static_assert(result.error != regmask_merge_error::set_cleared, "set/clear check failed: setting a bit which was previously cleared");
+  static_assert(result.error != regmask_merge_error::clear_set,   "set/clear check failed: clearing a bit which was previously set");
+  static_assert(result.error != regmask_merge_error::width,       "template argument is not of same reg<> type");
+
+  using indexed = indexed_types< make_index_sequence< size >, Tp... >;
+
+  template<std::size_t i>
+  using element_at = typename decltype(type_at< i >(static_cast< indexed const * >(nullptr)))::type;
+
+  template<typename S>
+  struct check_reg_type;
+  template<std::size_t... I>
+  struct check_reg_type< index_sequence< I... > > {
+    static constexpr bool value = all_of<
+      std::is_same< typename Tp::reg_type, typename element_at< result.first[I] >::reg_type >::value...
+      >::value;
+  };
+  static_assert(check_reg_type< make_index_sequence< size > >::value, "template argument is not of same reg<> type");
+
+  /** Merged regmask of the register of element i (the element itself if it is the only one) */
+  template<std::size_t i, typename Tf = element_at< i >, typename reg_type = typename Tf::reg_type>
+  using merged_at = typename std::conditional<
+    result.count[i] == 1,
+    Tf,
+    regmask< reg_type,
+             static_cast<typename reg_type::value_type>(result.merged[i].set_mask),
+             static_cast<typename reg_type::value_type>(result.merged[i].clear_mask) >
+    >::type;
+
+  struct filter_first {
+    template<typename T>
+    using filter = std::integral_constant< bool, result.first[T::value] == T::value >;
+  };
+
+  template<typename S>
+  struct first_indices;
+  template<std::size_t... I>
+  struct first_indices< index_sequence< I... > > {
+    using type = typename make_filtered_list<
+      sane_typelist<>,
+      filter_first,
+      std::integral_constant< std::size_t, I >...
+      >::type;
+  };
+
+  template<typename L>
+  struct merged_list;
+  template<typename... I>
+  struct merged_list< sane_typelist< I... > > {
+    using type = sane_typelist< merged_at< I::value >... >;
+  };
+
+  template<typename S>
+  struct ordered_list;
+  template<std::size_t... K>
+  struct ordered_list< index_sequence< K... > > {
+    using type = sane_typelist< merged_at< result.ordered[K] >... >;
+  };
+
+  using type = typename merged_list< typename first_indices< make_index_sequence< size > >::type >::type;
+  using ordered_type = typename ordered_list< make_index_sequence< result.distinct > >::type;
+};
+
+template<typename... Tp>
+constexpr regmask_value constexpr_merged_regmask_list< sane_typelist< Tp... > >::values[];
+template<typename... Tp>
+constexpr typename constexpr_merged_regmask_list< sane_typelist< Tp... > >::result_type constexpr_merged_regmask_list< sane_typelist< Tp... > >::result;
+
+/** Deduces the sane_typelist<> base of list_type (use in decltype only) */
+template<typename... Tp>
+sane_typelist< Tp... > sane_typelist_of(sane_typelist< Tp... > const *);
+
+template<typename list_type>
+struct unique_merged_regmask_list
+: constexpr_merged_regmask_list< decltype(sane_typelist_of(static_cast< list_type const * >(nullptr))) >
+{ };
+
+#endif // CONFIG_REGLIST_CONSTEXPR_MERGE
+
+
+/**
+ * Test a register value against the set/clear masks of regmask
+ * elements (Tp...). A regmask matches if (value & clear_mask) ==
+ * set_mask. Regmasks with empty clear_mask never match in any().
+ */
+template<typename... Tp>
+struct regmask_value_test {
+  template<typename value_type>
+  static constexpr bool any(value_type const) { return false; }
+};
+template<typename Head, typename... Tail>
+struct regmask_value_test<Head, Tail...> {
+  using value_type = typename Head::value_type;
+
+  static constexpr bool any(value_type const value) {
+    return ((Head::clear_mask != 0) && ((value & Head::clear_mask) == Head::set_mask))
+      || regmask_value_test<Tail...>::any(value);
+  }
+};
+
+struct pack_regmask_value_test {
+  template<typename... Tp>
+  struct pack {
+    using type = regmask_value_test<Tp...>;
+  };
+};
+
+
+/**
+ * Test functions on a list of distinct merged regmasks (Tm...),
+ * performing at most one reg_type::load() per merged regmask (aka:
+ * per distinct register). Evaluation stops on the first register
+ * deciding the result.
+ *
+ * list_type holds the (unmerged) regmask elements, needed for any().
+ */
+template<typename list_type, typename... Tm>
+struct reg_test_impl {
+  static __always_inline bool all(void) { return true;  }
+  static __always_inline bool any(void) { return false; }
+};
+template<typename list_type, typename Head, typename... Tail>
+struct reg_test_impl<list_type, Head, Tail...> {
+  using reg_type      = typename Head::reg_type;
+  using filtered_list = typename list_type::template filter< filter_reg_type<Head> >::type;
+  using value_test    = typename filtered_list::template pack< pack_regmask_value_test >::type;
+
+  /** true if the merged set/clear mask matches the register value */
+  static __always_inline bool all(void) {
+    if(Head::clear_mask != 0) {  /* evaluated at compile-time */
+      if((reg_type::load() & Head::clear_mask) != Head::set_mask)
+        return false;
+    }
+    return reg_test_impl<list_type, Tail...>::all();
+  }
+
+  /** true if any regmask element matches the register value */
+  static __always_inline bool any(void) {
+    return value_test::any(reg_type::load()) || reg_test_impl<list_type, Tail...>::any();
+  }
+};
+
+template<typename list_type>
+struct pack_reg_test {
+  template<typename... Tm>
+  struct pack {
+    using type = reg_test_impl<list_type, Tm...>;
+  };
+};
+
+
 /**
  * Calls ::reset_to() on a given typelist element type.
  *
@@ -159,6 +531,10 @@ struct functor_reg_reset_to {
  * This results in a read-modify-write access and is thus much
  * slower. Depending on register and/or processor type, you might
  * want to choose this functor.
+ *
+ * NOTE: If the clear_mask of the (merged) regmask covers all bits of
+ * the register (regmask::full_coverage), no read is performed, and
+ * set() results in a single store() like reset_to().
  */
 struct functor_reg_set {
   template<typename list_element_type>
@@ -178,37 +554,412 @@ struct functor_reg_clear {
 };
 
 
-#if 0
-enum class write_strategy {
-  read_modify_write,
-  reset_to
-}; 
+/**
+ * Calls the write function matching write_strategy on a given
+ * typelist element type (merged regmask<> type).
+ */
+template<write_strategy strategy>
+struct functor_reg_write;
+
+template<>
+struct functor_reg_write< write_strategy::rmw >
+: functor_reg_set
+{ };
+
+template<>
+struct functor_reg_write< write_strategy::reset_to >
+: functor_reg_reset_to
+{ };
+
+template<>
+struct functor_reg_write< write_strategy::blind_store > {
+  template<typename list_element_type>
+  static void __always_inline command(void) {
+    list_element_type::reg_type::store(list_element_type::set_mask);
+  }
+};
+
+/**
+ * Provides the write_strategy chosen at compile-time for a merged
+ * regmask<> type (Rm), with following precedence:
+ *
+ *   - blind_store : clear_mask covers all bits of the register
+ *   - reset_to    : write-only register (cannot be read)
+ *   - rmw         : otherwise
+ *
+ * NOTE: If the register values are known to be equal to their reset
+ * values (e.g. right after core::startup), use
+ * write_strategy::reset_to, which never loads a register.
+ */
+template<typename Rm>
+struct auto_write_strategy {
+  static constexpr write_strategy value =
+    Rm::full_coverage                     ? write_strategy::blind_store :
+    (Rm::reg_type::permission == wo)      ? write_strategy::reset_to :
+    write_strategy::rmw;
+};
+
+template<>
+struct functor_reg_write< write_strategy::automatic > {
+  template<typename list_element_type>
+  static void __always_inline command(void) {
+    functor_reg_write< auto_write_strategy< list_element_type >::value >::template command< list_element_type >();
+  }
+};
+
+
+/**
+ * Register bits known after writing a merged regmask<> type (Rm,
+ * void if not written) using write_strategy:
+ *
+ *   - known_mask : bits holding a known value
+ *   - value      : value of the known bits
+ */
+template<write_strategy strategy, typename value_type, typename Rm>
+struct written_state {
+  static_assert(strategy != write_strategy::automatic, "write_strategy::automatic is not supported here");
+
+  static constexpr value_type known_mask = (strategy == write_strategy::rmw) ?
+    Rm::clear_mask : static_cast<value_type>(~static_cast<value_type>(0));
+
+  static constexpr value_type value = (strategy == write_strategy::reset_to) ?
+    (Rm::reg_type::reset_value & ~Rm::cropped_clear_mask) | Rm::set_mask : Rm::set_mask;
+};
+template<write_strategy strategy, typename value_type>
+struct written_state<strategy, value_type, void> {
+  static constexpr value_type known_mask = 0;
+  static constexpr value_type value      = 0;
+};
+
+
+/**
+ * Number of register accesses emitted for writing a merged regmask<>
+ * type (Rm) using write_strategy (see regmask::set()):
+ *
+ *   - stores : store(), narrow and bit-band stores
+ *   - loads  : load() of the register (not counting shadowed
+ *              registers, which are loaded from RAM)
+ */
+template<write_strategy strategy, typename Rm>
+struct reg_write_count {
+  static constexpr bool rmw_needed = !(Rm::full_coverage || Rm::lane_enabled || Rm::set_reset_enabled || Rm::bitop_set());
+
+  static constexpr std::size_t stores =
+    (strategy != write_strategy::rmw) ? 1 :
+    (Rm::full_coverage || Rm::lane_enabled || Rm::set_reset_enabled) ? 1 :
+    Rm::bitop_set() ? Rm::bitcount::value :
+    ((Rm::set_mask == 0) && (Rm::clear_mask == 0)) ? 0 :
+    1;
+
+  static constexpr std::size_t loads =
+    ((strategy == write_strategy::rmw) && rmw_needed && (stores != 0) && !Rm::reg_type::shadowed) ? 1 : 0;
+};
+template<typename Rm>
+struct reg_write_count< write_strategy::automatic, Rm >
+: reg_write_count< auto_write_strategy< Rm >::value, Rm >
+{ };
+
+/**
+ * Entry of a register report: register address, and value after
+ * writing (only the bits in known_mask are known for
+ * write_strategy::rmw).
+ */
+struct reg_report_entry {
+  reg_addr_t     addr;
+  std::uintmax_t value;
+  std::uintmax_t known_mask;
+};
+
+/** Sum of values[lo..hi) (constexpr recursion depth: log2(N)) */
+constexpr std::size_t array_sum(std::size_t const * values, std::size_t lo, std::size_t hi) {
+  return (hi - lo == 0) ? 0 :
+    (hi - lo == 1) ? values[lo] :
+    array_sum(values, lo, lo + (hi - lo) / 2) + array_sum(values, lo + (hi - lo) / 2, hi);
+}
+
+/**
+ * Compile-time report of the register writes performed by
+ * reglist::apply<strategy>() on the merged regmask<> types Rm... (in
+ * register write order). See reglist::report.
+ */
+template<write_strategy strategy, typename... Rm>
+struct reg_report {
+  static constexpr std::size_t size = sizeof...(Rm);
+
+  template<typename T>
+  using resolved = written_state<
+    (strategy == write_strategy::automatic) ? auto_write_strategy<T>::value : strategy,
+    typename T::value_type, T >;
+
+  static constexpr std::size_t stores_of[size + 1] = { reg_write_count<strategy, Rm>::stores..., 0 };
+  static constexpr std::size_t loads_of[size + 1]  = { reg_write_count<strategy, Rm>::loads...,  0 };
+
+  /** Register values after writing, in register write order */
+  static constexpr reg_report_entry table[size + 1] = {
+    { Rm::reg_type::addr, resolved<Rm>::value, resolved<Rm>::known_mask }...,
+    { 0, 0, 0 }
+  };
+
+  /** Number of registers written */
+  static constexpr std::size_t numof_registers = size;
+
+  /** Number of stores emitted */
+  static constexpr std::size_t numof_stores = array_sum(stores_of, 0, size);
+
+  /** Number of register loads emitted */
+  static constexpr std::size_t numof_loads = array_sum(loads_of, 0, size);
+
+  /** Index of register at addr in table[], or size if not present */
+  static constexpr std::size_t index(reg_addr_t addr, std::size_t lo = 0, std::size_t hi = size) {
+    return (hi - lo == 0) ? size :
+      (hi - lo == 1) ? ((table[lo].addr == addr) ? lo : size) :
+      (index(addr, lo, lo + (hi - lo) / 2) != size) ? index(addr, lo, lo + (hi - lo) / 2) :
+      index(addr, lo + (hi - lo) / 2, hi);
+  }
+
+  /** True if the register at addr is written */
+  static constexpr bool contains(reg_addr_t addr) {
+    return index(addr) != size;
+  }
+
+  /** Value of the register at addr after writing (0 if not written) */
+  static constexpr std::uintmax_t value(reg_addr_t addr) {
+    return table[index(addr)].value;
+  }
+
+  /** Bits of the register at addr with known value after writing (0 if not written) */
+  static constexpr std::uintmax_t known_mask(reg_addr_t addr) {
+    return table[index(addr)].known_mask;
+  }
+
+#ifdef OPENMPTL_SIMULATION
+  struct functor_dump {
+    template<typename T>
+    static void command(void) {
+      using value_type = typename T::value_type;
+      sim::reg_dumper<value_type, T::reg_type::addr>::dump_register_value(
+        "=", resolved<T>::value, resolved<T>::known_mask);
+    }
+  };
+
+  /**
+   * Print the register values after writing (register names from
+   * address_map<>), and the number of accesses.
+   */
+  static void dump(void) {
+    sim::regdump_ostream << std::dec
+                         << "*** reglist report: " << numof_registers << " registers, "
+                         << numof_stores << " stores, " << numof_loads << " loads" << std::endl;
+    for_each_impl< functor_dump, Rm... >::command();
+  }
+#endif // OPENMPTL_SIMULATION
+};
+
+template<write_strategy strategy, typename... Rm>
+constexpr std::size_t reg_report<strategy, Rm...>::stores_of[];
+template<write_strategy strategy, typename... Rm>
+constexpr std::size_t reg_report<strategy, Rm...>::loads_of[];
+template<write_strategy strategy, typename... Rm>
+constexpr reg_report_entry reg_report<strategy, Rm...>::table[];
+
+template<write_strategy strategy>
+struct pack_reg_report {
+  template<typename... Rm>
+  struct pack {
+    using type = reg_report<strategy, Rm...>;
+  };
+};
+
 
 /**
- * Call reg::reset_to() on each distinct merged regmask from list.
- * Ignores all non-regmask<> types in list.
+ * Map each merged regmask (aka: Tp) of the target list to a regmask
+ * which transitions its register from the state written by the
+ * (unmerged) regmasks in from_list to the state written by Tp, both
+ * written using write_strategy. Maps to void if the register is
+ * already in the target state.
  *
- * Also see the "functor_reg_reset_to" documentation in
- * register_mpl.hpp for a discussion about reset_to() and set().
+ *   - if all bits of the target state are known (reset_to,
+ *     blind_store), the mapped regmask covers all register bits,
+ *     resulting in a single store().
+ *   - otherwise (rmw), the mapped regmask only covers the changed
+ *     bits.
+ */
+template<write_strategy strategy, typename from_list>
+struct map_transition_regmask {
+  template<typename Tp, typename list_type>
+  struct map {
+    using reg_type   = typename Tp::reg_type;
+    using value_type = typename Tp::value_type;
+    using Rf = typename from_list::template filter< filter_reg_type<Tp> >::type::template pack< pack_merged_regmask >::type;
+
+    using from = written_state<strategy, value_type, Rf>;
+    using to   = written_state<strategy, value_type, Tp>;
+
+    static constexpr value_type changed = to::known_mask & ~(from::known_mask & ~(from::value ^ to::value));
+    static constexpr value_type clear_mask = (to::known_mask == static_cast<value_type>(~static_cast<value_type>(0))) ? to::known_mask : changed;
+
+    using type = typename std::conditional<
+      changed == 0,
+      void,
+      regmask< reg_type, to::value & clear_mask, clear_mask >
+      >::type;
+  };
+};
+
+
+/**
+ * Provides the unsigned integral type of given size (bytes).
+ */
+template<unsigned size> struct uint_of_size;
+template<> struct uint_of_size<1> { using type = std::uint8_t;  };
+template<> struct uint_of_size<2> { using type = std::uint16_t; };
+template<> struct uint_of_size<4> { using type = std::uint32_t; };
+template<> struct uint_of_size<8> { using type = std::uint64_t; };
+
+
+/**
+ * Entry of a register table: register address and value.
  */
-template< typename typelist_type,
-  write_strategy strategy = write_strategy::read_modify_write,
-  typename... Tf
-  >
-static void regmask_write() {
-  using regmask_list = typename typelist_type::template filter_type< regmask_tag >;
-  using merged_list  = typename regmask_list::template map< mpl::map_merged_regmask >;
-  using unique_merged_list = typename merged_list::filter_unique::type;
+template<typename value_type>
+struct reg_table_entry {
+  reg_addr_t addr;
+  value_type value;
+#ifdef OPENMPTL_SIMULATION
+  void (*store)(value_type);  /* reg_access::store(): register dump and reactions */
+#endif
+};
 
-  if(strategy == write_strategy::read_modify_write)
-    unique_merged_list::template for_each< mpl::functor_reg_set >();
-  else
-    unique_merged_list::template for_each< mpl::functor_reg_reset_to >();
+#ifdef OPENMPTL_SIMULATION
+template<typename reg_type, typename value_type>
+void reg_table_store(value_type const value) {
+  reg_type::store(value);
 }
 #endif
 
+/**
+ * Calls reg_type::stored() on a given typelist element type (merged
+ * regmask<> type), for registers written by reg_table.
+ */
+template<write_strategy strategy>
+struct functor_reg_stored {
+  template<typename list_element_type>
+  static void __always_inline command(void) {
+    using value_type = typename list_element_type::value_type;
+    list_element_type::reg_type::stored(written_state<strategy, value_type, list_element_type>::value);
+  }
+};
+
+/**
+ * Provides the strongest reg_barrier of the registers of Rm...
+ * (ordered: none < dmb < dsb < dsb_isb).
+ */
+template<typename... Rm>
+struct strongest_reg_barrier {
+  static constexpr reg_barrier value = reg_barrier::none;
+};
+template<typename Head, typename... Tail>
+struct strongest_reg_barrier<Head, Tail...> {
+  static constexpr reg_barrier head  = Head::reg_type::barrier;
+  static constexpr reg_barrier tail  = strongest_reg_barrier<Tail...>::value;
+  static constexpr reg_barrier value = (static_cast<int>(head) > static_cast<int>(tail)) ? head : tail;
+};
+
+/**
+ * Table of register values, written in a loop by apply().
+ *
+ * Holds the values written by merged regmask<> types (Rm...) using
+ * write_strategy (reset_to or blind_store), all registers of same
+ * size (value_type). The table is placed in .rodata: this results
+ * in considerably smaller code than one store() per register
+ * (loading address and value from the literal pool) for long lists,
+ * at the cost of a few cycles per register.
+ */
+template<write_strategy strategy, typename value_type, typename... Rm>
+struct reg_table {
+  static_assert(strategy == write_strategy::reset_to || strategy == write_strategy::blind_store,
+                "table emission requires write_strategy::reset_to or write_strategy::blind_store");
+  static_assert(all_true< std::integral_constant<bool, Rm::reg_type::permission != ro>... >::value,
+                "write access to a read-only register");
+
+  static constexpr reg_table_entry<value_type> table[] = {
+    { Rm::reg_type::addr,
+      written_state<strategy, typename Rm::value_type, Rm>::value
+#ifdef OPENMPTL_SIMULATION
+      , reg_table_store<typename Rm::reg_type, value_type>
+#endif
+    }...
+  };
+
+  static void apply(void) {
+    for(auto const & entry : table) {
+#ifdef OPENMPTL_SIMULATION
+      entry.store(entry.value);
+#else
+      *reinterpret_cast<volatile value_type *>(entry.addr) = entry.value;
+#endif
+    }
+#ifndef OPENMPTL_SIMULATION
+    /* single barrier for the whole table (sim: dumped on each store) */
+    memory_barrier::after_store< strongest_reg_barrier<Rm...>::value >();
+    for_each_impl< functor_reg_stored<strategy>, Rm... >::command();
+#endif
+  }
+};
+
+template<write_strategy strategy, typename value_type, typename... Rm>
+constexpr reg_table_entry<value_type> reg_table<strategy, value_type, Rm...>::table[];
+
+
+/**
+ * Split a list of merged regmasks into runs of consecutive registers
+ * of same size, providing a list of reg_table<> types.
+ */
+template<typename Rm>
+using reg_table_value_type = typename uint_of_size< sizeof(typename Rm::value_type) >::type;
+
+template<write_strategy strategy, typename run_list, typename current_run, typename... Rm>
+struct make_reg_table_runs;
+
+template<write_strategy strategy, typename... Runs, typename current_run>
+struct make_reg_table_runs<strategy, sane_typelist< Runs... >, current_run> {
+  using type = sane_typelist< Runs..., current_run >;
+};
+
+template<write_strategy strategy, typename... Runs, typename value_type, typename... Cur, typename Head, typename... Tail>
+struct make_reg_table_runs<strategy, sane_typelist< Runs... >, reg_table< strategy, value_type, Cur... >, Head, Tail...> {
+  using type = typename std::conditional<
+    std::is_same< value_type, reg_table_value_type<Head> >::value,
+    make_reg_table_runs< strategy, sane_typelist< Runs... >, reg_table< strategy, value_type, Cur..., Head >, Tail... >,
+    make_reg_table_runs< strategy, sane_typelist< Runs..., reg_table< strategy, value_type, Cur... > >, reg_table< strategy, reg_table_value_type<Head>, Head >, Tail... >
+    >::type::type;
+};
 
-template< unsigned x >
+template<write_strategy strategy>
+struct pack_reg_table_runs {
+  template<typename... Rm>
+  struct pack {
+    using type = sane_typelist<>;
+  };
+  template<typename Head, typename... Tail>
+  struct pack<Head, Tail...> {
+    using type = typename make_reg_table_runs<
+      strategy, sane_typelist<>, reg_table< strategy, reg_table_value_type<Head>, Head >, Tail...
+      >::type;
+  };
+};
+
+/**
+ * Calls ::apply() on a given typelist element type (reg_table<> type).
+ */
+struct functor_reg_table_apply {
+  template<typename list_element_type>
+  static void __always_inline command(void) {
+    list_element_type::apply();
+  }
+};
+
+
+template< std::uintmax_t x >
 struct bitcount {
   using bc = bitcount< x/2 >;
   static constexpr unsigned value = x & 1 ? bc::value + 1 : bc::value;
@@ -221,6 +972,32 @@ struct bitcount<0> {
   static constexpr unsigned significant_bits = 0;
 };
 
+
+/**
+ * Calls reg_type::bitset() or reg_type::bitclear() on each bit in
+ * mask, in ascending bit order.
+ */
+template< typename reg_type, std::uintmax_t mask >
+struct reg_bitop {
+  static constexpr unsigned bit_no = lowest_bit(mask);
+  using next = reg_bitop< reg_type, mask & (mask - 1) >;
+
+  static __always_inline void set(void) {
+    reg_type::template bitset< bit_no >();
+    next::set();
+  }
+  static __always_inline void clear(void) {
+    reg_type::template bitclear< bit_no >();
+    next::clear();
+  }
+};
+
+template< typename reg_type >
+struct reg_bitop< reg_type, 0 > {
+  static __always_inline void set(void) { }
+  static __always_inline void clear(void) { }
+};
+
 } } // namespace mptl::mpl
 
 #endif // REGISTER_MPL_HPP_INCLUDED
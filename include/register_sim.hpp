@@ -172,6 +172,19 @@ class reg_dumper
 
 public:
 
+  /**
+   * Print a register value computed at compile-time (see
+   * mpl::reg_report::dump()). If known_mask does not cover all bits,
+   * the known bits are printed in a second line.
+   */
+  static void dump_register_value(const std::string & desc, value_type value, value_type known_mask) {
+    REGDUMP_LOCK;
+    print_action(desc, value);
+    if(known_mask != static_cast<value_type>(~static_cast<value_type>(0)))
+      print_action("  (known)", known_mask, known_mask, 'K');
+    REGDUMP_UNLOCK;
+  }
+
   static void dump_register_load(value_type value) {
     RETURN_IF_REACTION;
 
@@ -191,6 +204,17 @@ public:
     REGDUMP_UNLOCK;
   }
 
+  static void dump_register_atomic_set(value_type cur_value, value_type new_value) {
+    std::string desc = REACTION_CONDITIONAL("::atomic()", "##atomic()");
+    if(cur_value == new_value)  // notify with '~' if cur=new (candidates for optimization!)
+      desc.append("~");
+
+    REGDUMP_LOCK;
+    print_reg_value(cur_value);
+    print_action(desc, new_value);
+    REGDUMP_UNLOCK;
+  }
+
   static void dump_register_bitset(value_type cur_value, unsigned bit_no) {
     std::string desc = REACTION_CONDITIONAL("::bitset()", "##bitset()");
     value_type mask = 1 << bit_no;
@@ -215,6 +239,30 @@ public:
     REGDUMP_UNLOCK;
   }
 
+  static void dump_register_lane_store(value_type cur_value, value_type written, value_type mask, unsigned width) {
+    std::string desc = REACTION_CONDITIONAL("::store", "##store");
+    desc.append(width == 8 ? "8()" : "16()");
+    value_type new_value = (cur_value & ~mask) | written;
+    if(cur_value == new_value)  // notify with '~' if cur=new (candidates for optimization!)
+      desc.append("~");
+
+    REGDUMP_LOCK;
+    print_reg_value(cur_value);
+    print_action(desc, new_value);
+    REGDUMP_UNLOCK;
+  }
+
+  static void dump_register_barrier(value_type cur_value, reg_barrier barrier) {
+    RETURN_IF_REACTION;
+
+    const char * desc = (barrier == reg_barrier::dmb) ? "::dmb()" :
+      (barrier == reg_barrier::dsb) ? "::dsb()" : "::dsb_isb()";
+
+    REGDUMP_LOCK;
+    print_action(desc, cur_value);
+    REGDUMP_UNLOCK;
+  }
+
   static void dump_register_bittest(value_type cur_value, value_type bit_no) {
     RETURN_IF_REACTION;
 
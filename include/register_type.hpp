@@ -25,8 +25,96 @@
 
 namespace mptl {
 
-/** Register access permission */
-enum reg_perm { ro, wo, rw };
+/**
+ * Register access permission
+ *
+ *   - ro    : read-only
+ *   - wo    : write-only
+ *   - rw    : read-write, may be modified by hardware
+ *   - rw_sw : read-write, modified by software only. load() is
+ *             served from a RAM shadow if CONFIG_REGISTER_SHADOW is
+ *             defined (see reg_access).
+ *   - rw_wc : read-write, holding flag bits cleared by writing 0 or 1
+ *             (rc_w0/rc_w1, e.g. status registers). Never written by
+ *             bit-band stores, which write back all other bits.
+ */
+enum reg_perm { ro, wo, rw, rw_sw, rw_wc };
+
+/**
+ * Strategy for writing a merged regmask to its register (see
+ * reglist::apply()).
+ */
+enum class write_strategy {
+  rmw,          /**< read-modify-write: regmask::set()                                 */
+  reset_to,     /**< single store() of reset_value, merged with regmask::reset_to()    */
+  blind_store,  /**< single store() of set_mask, all other bits are written as zero    */
+  automatic     /**< chosen per register at compile-time (see mpl::auto_write_strategy) */
+};
+
+/**
+ * Access policy for regmask::set() and regmask::clear().
+ */
+enum class access_policy {
+  fast,         /**< cheapest access, chosen by the cost model in arch/bitband.hpp     */
+  atomic        /**< prefer accesses which are atomic against interrupts (bit-band)   */
+};
+
+/**
+ * Memory barrier emitted after every write access to a register
+ * (see reg<>, and arch/barrier.hpp).
+ *
+ * Stores are buffered on the bus: without a barrier, e.g. clearing
+ * an interrupt flag as last instruction of an ISR can complete only
+ * after exception return, resulting in spurious re-entry of the ISR.
+ */
+enum class reg_barrier {
+  none,         /**< no barrier (default)                                                   */
+  dmb,          /**< data memory barrier: store is ordered before subsequent memory accesses */
+  dsb,          /**< data synchronization barrier: store is completed                       */
+  dsb_isb       /**< dsb, followed by isb: new state is effective for subsequent instructions */
+};
+
+/**
+ * Narrowest store supported by a register (see reg<>). Fields
+ * covering exactly one aligned lane of this size (or larger) are
+ * written by a single narrow store (strb/strh), instead of a
+ * read-modify-write of the whole register.
+ */
+enum class reg_lane {
+  none,         /**< register is written as a whole (default)    */
+  halfword,     /**< 16bit stores on halfword boundaries           */
+  byte          /**< 8bit or 16bit stores on byte/halfword boundaries */
+};
+
+/**
+ * Consistent read strategy of a reg_pair<> (value split into a
+ * high and a low register).
+ */
+enum class reg_pair_read {
+  reread_high,  /**< read high, low, high again; retry if high changed (e.g. running counters) */
+  latched       /**< read low, then high: hardware latches the high half on low read           */
+};
+
+/**
+ * Code emission for writing the registers of a reglist<> (see
+ * reglist::apply()).
+ */
+enum class reglist_emission {
+  unrolled,     /**< one store() per register (immediate address and value)                  */
+  table,        /**< table of {addr, value} in .rodata, written in a loop (see mpl::reg_table) */
+  automatic     /**< table if the list holds at least reglist_table_threshold registers      */
+};
+
+/**
+ * Minimum number of registers for reglist_emission::automatic to
+ * emit a table, 0=never (default). Set by defining
+ * CONFIG_REGLIST_TABLE_THRESHOLD=<n>.
+ */
+#ifdef CONFIG_REGLIST_TABLE_THRESHOLD
+static constexpr unsigned reglist_table_threshold = CONFIG_REGLIST_TABLE_THRESHOLD;
+#else
+static constexpr unsigned reglist_table_threshold = 0;
+#endif
 
 #ifndef OPENMPTL_SIMULATION
 /** Register address type (uintptr_t: unsigned integer type capable of holding a pointer)  */
@@ -0,0 +1,204 @@
+/*
+ * OpenMPTL - C++ Microprocessor Template Library
+ *
+ * Copyright (C) 2012-2017 Axel Burri <axel@tty0.ch>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef REGISTER_WAIT_HPP_INCLUDED
+#define REGISTER_WAIT_HPP_INCLUDED
+
+/*
+ * Bounded register polling.
+ *
+ * Examples:
+ *
+ *   - wait forever, until HSERDY is set:
+ *
+ *       wait_until< RCC::CR::HSERDY >();
+ *
+ *   - wait at most 500us, using WFE between polls:
+ *
+ *       if(wait_until< RCC::CR::HSERDY, wait_backoff::wfe >(wait_timeout::us< sysclk >(500)) == wait_result::timeout)
+ *         ...
+ *
+ *   - wait while BSY is set, at most 10000 cycles:
+ *
+ *       wait_while< SPI1::SR::BSY >(wait_timeout::cycles(10000));
+ */
+
+#include <cstdint>
+#include <compiler.h>
+
+#ifdef OPENMPTL_SIMULATION
+#  include <thread>
+#  undef CONFIG_WAIT_CYCLE_COUNTER  /* polls are counted in simulation */
+#endif
+
+#ifdef CONFIG_WAIT_CYCLE_COUNTER
+#  include <arch/dwt.hpp>
+#endif
+
+namespace mptl {
+
+/** Result of a wait_until() / wait_while() call */
+enum class wait_result {
+  ok,           /**< condition met                     */
+  timeout       /**< timeout expired, condition not met */
+};
+
+/** Action performed between two polls of the condition */
+enum class wait_backoff {
+  spin,         /**< poll again immediately                                                */
+  wfe           /**< wait for event (low power), requires an event source (e.g. SEVONPEND) */
+};
+
+/**
+ * Timeout of a wait, in processor (HCLK) cycles.
+ *
+ * Per default, elapsed time is estimated by counting polls (each
+ * poll_cycles long). This needs no hardware, but is imprecise
+ * (especially with wait_backoff::wfe, where the time spent asleep is
+ * not known). With CONFIG_WAIT_CYCLE_COUNTER defined, elapsed time
+ * is measured using the DWT cycle counter, which must be enabled
+ * (see cycle_counter in arch/dwt.hpp).
+ *
+ * The condition is always polled at least once: a timeout of 0
+ * cycles results in a single poll.
+ */
+struct wait_timeout
+{
+  /**
+   * Number of cycles per poll (load, test, branch, count). This is a
+   * rough estimate, not a measured value: the actual number depends
+   * on the condition, the flash wait states and the generated code.
+   * Use CONFIG_WAIT_CYCLE_COUNTER if the timeout needs to be precise.
+   */
+  static constexpr uint32_t poll_cycles = 8;
+
+  uint32_t const value;     /**< cycles                     */
+  bool     const infinite;  /**< wait forever, ignore value */
+
+  /** Wait forever (no timeout) */
+  static constexpr wait_timeout forever(void) {
+    return wait_timeout{ 0, true };
+  }
+
+  /** Timeout in processor cycles */
+  static constexpr wait_timeout cycles(uint32_t n) {
+    return wait_timeout{ n, false };
+  }
+
+  /**
+   * Timeout in microseconds, derived from system_clock_type::hclk_freq.
+   *
+   * NOTE: If n * (hclk_freq / 1MHz) exceeds the cycle range (32bit),
+   * compilation fails if evaluated in a constant expression, and the
+   * timeout is saturated to the maximum cycle count otherwise.
+   */
+  template<typename system_clock_type>
+  static constexpr wait_timeout us(uint32_t n) {
+    static_assert(system_clock_type::hclk_freq >= 1000000, "hclk_freq below 1MHz, use wait_timeout::cycles()");
+    return (n <= UINT32_MAX / (system_clock_type::hclk_freq / 1000000)) ?
+      wait_timeout{ n * static_cast<uint32_t>(system_clock_type::hclk_freq / 1000000), false } :
+      us_overflow();
+  }
+
+private:
+  /* not constexpr: fails compilation of constant expressions calling us() with overflow */
+  static wait_timeout us_overflow(void) {
+    return wait_timeout{ UINT32_MAX, false };
+  }
+};
+
+
+namespace mpl {
+
+template<wait_backoff backoff>
+struct wait_backoff_impl;
+
+template<>
+struct wait_backoff_impl<wait_backoff::spin> {
+  static __always_inline void relax(void) {
+#ifdef OPENMPTL_SIMULATION
+    std::this_thread::yield();  /* do not burn a host core */
+#endif
+  }
+};
+
+template<>
+struct wait_backoff_impl<wait_backoff::wfe> {
+  static __always_inline void relax(void) {
+#ifdef OPENMPTL_SIMULATION
+    std::this_thread::yield();
+#else
+    __asm volatile ("wfe");
+#endif
+  }
+};
+
+/**
+ * Poll Cond::test() until it returns expected, or until timeout.
+ */
+template<typename Cond, bool expected, wait_backoff backoff>
+struct wait_impl
+{
+  static wait_result poll(wait_timeout const timeout) {
+#ifdef CONFIG_WAIT_CYCLE_COUNTER
+    uint32_t const start = dwt::cycle_counter_load();
+#else
+    uint32_t remaining = timeout.value;  /* counting down, no overflow on large timeouts */
+#endif
+    while(Cond::test() != expected) {
+      if(!timeout.infinite) {
+#ifdef CONFIG_WAIT_CYCLE_COUNTER
+        if(dwt::cycle_counter_load() - start >= timeout.value)
+          return wait_result::timeout;
+#else
+        if(remaining <= wait_timeout::poll_cycles)
+          return wait_result::timeout;
+        remaining -= wait_timeout::poll_cycles;
+#endif
+      }
+      wait_backoff_impl<backoff>::relax();
+    }
+    return wait_result::ok;
+  }
+};
+
+} // namespace mpl
+
+
+/**
+ * Wait until Cond::test() returns true (e.g. regmask<>, regbits<>,
+ * regval<> or reglist<> type), or until timeout.
+ */
+template<typename Cond, wait_backoff backoff = wait_backoff::spin>
+inline wait_result wait_until(wait_timeout const timeout = wait_timeout::forever()) {
+  return mpl::wait_impl<Cond, true, backoff>::poll(timeout);
+}
+
+/**
+ * Wait while Cond::test() returns true, or until timeout.
+ */
+template<typename Cond, wait_backoff backoff = wait_backoff::spin>
+inline wait_result wait_while(wait_timeout const timeout = wait_timeout::forever()) {
+  return mpl::wait_impl<Cond, false, backoff>::poll(timeout);
+}
+
+} // namespace mptl
+
+#endif // REGISTER_WAIT_HPP_INCLUDED
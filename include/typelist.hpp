@@ -104,6 +104,9 @@ public:
 
   using type = sane_typelist< Tp... >;
 
+  /** Number of elements in the list */
+  static constexpr unsigned size = sizeof...(Tp);
+
 #ifdef CONFIG_USE_STD_TUPLE
   using tuple_type = std::tuple<Tp...>;
 #endif // CONFIG_USE_STD_TUPLE
@@ -177,6 +180,47 @@ public:
    */
   using filter_unique = typename mpl::make_unique_list< sane_typelist<>, Tp... >::type;
 
+  /**
+   * Provides a list of all elements, sorted by their key (stable, no
+   * recursion on the elements: O(N log N) instantiations).
+   *
+   * Key must provide "key<T>", an std::integral_constant<> holding
+   * the sort key of element T, e.g.:
+   *
+   *     struct addr_key {
+   *       template<typename T>
+   *       using key = std::integral_constant< reg_addr_t, T::reg_type::addr >;
+   *     };
+   *     using sorted = list::sort< addr_key >;
+   *
+   * NOTE: keys are compared as std::intmax_t.
+   */
+  template<typename Key>
+  using sort = typename mpl::sort_list< mpl::key_order< Key >, Tp... >::type;
+
+  /**
+   * Provides a list of lists, holding the elements grouped by equal
+   * keys (see sort above). The groups are ordered by key, the
+   * elements within a group keep their list order.
+   */
+  template<typename Key>
+  using group_by = typename mpl::group_list< mpl::key_order< Key >, Tp... >::type;
+
+  /**
+   * Provides two lists: "first" holding the elements for which
+   * condition_type::filter<T> holds, "second" holding the others
+   * (both in list order).
+   */
+  template<typename condition_type>
+  struct partition {
+    struct inverse_condition {
+      template<typename T>
+      using filter = std::integral_constant< bool, !condition_type::template filter<T>::type::value >;
+    };
+    using first  = filter< condition_type >;
+    using second = filter< inverse_condition >;
+  };
+
   /**
    * Provides a list, where each element Tp is replaced by:
    * "T::map<Tp, type>::type", where "type" is our list class type.
@@ -33,7 +33,12 @@
 //template<typename T> struct incomplete;
 //incomplete<bad_type> debug;
 
-namespace mptl { namespace mpl {
+namespace mptl {
+
+template<typename... Tp>
+class sane_typelist;
+
+namespace mpl {
 
 
 ////////////////////  list_cat_impl  ////////////////////
@@ -52,11 +57,183 @@ struct list_cat_impl<L, R> {
 #endif // disabled
 
 
+////////////////////  index_sequence  ////////////////////
+
+
+/**
+ * Compile-time sequence of indices (C++14 std::index_sequence).
+ *
+ * make_index_sequence<N> provides index_sequence<0, 1, ..., N-1>,
+ * built by halving N (instantiation depth: log2(N)).
+ */
+template< std::size_t... I >
+struct index_sequence {
+  using type = index_sequence;
+  static constexpr std::size_t size = sizeof...(I);
+};
+
+template< typename S1, typename S2 >
+struct concat_index_sequence;
+template< std::size_t... I1, std::size_t... I2 >
+struct concat_index_sequence< index_sequence< I1... >, index_sequence< I2... > > {
+  using type = index_sequence< I1..., (sizeof...(I1) + I2)... >;
+};
+
+template< std::size_t N >
+struct make_index_sequence_impl {
+  using type = typename concat_index_sequence<
+    typename make_index_sequence_impl< N / 2 >::type,
+    typename make_index_sequence_impl< N - N / 2 >::type
+    >::type;
+};
+template<> struct make_index_sequence_impl< 0 > { using type = index_sequence<>; };
+template<> struct make_index_sequence_impl< 1 > { using type = index_sequence< 0 >; };
+
+template< std::size_t N >
+using make_index_sequence = typename make_index_sequence_impl< N >::type;
+
+
+////////////////////  all_of, any_of  ////////////////////
+
+
+template< bool... B >
+struct bool_pack;
+
+/**
+ * Type trait providing value=true if all B are true (or if B is
+ * empty). Evaluated by pack expansion, without recursion.
+ */
+template< bool... B >
+struct all_of
+: std::is_same< bool_pack< true, B... >, bool_pack< B..., true > >
+{ };
+
+/**
+ * Type trait providing value=true if any B is true.
+ */
+template< bool... B >
+struct any_of
+: std::integral_constant< bool, !all_of< !B... >::value >
+{ };
+
+
+////////////////////  type_at  ////////////////////
+
+
+template< typename T >
+struct type_wrap {
+  using type = T;
+};
+
+template< std::size_t I, typename T >
+struct indexed_type
+{ };
+
+/**
+ * Inherits indexed_type<I, T> for each element T at position I.
+ * Used for element lookup by index (see type_at) with constant
+ * instantiation depth.
+ */
+template< typename S, typename... Tp >
+struct indexed_types;
+template< std::size_t... I, typename... Tp >
+struct indexed_types< index_sequence< I... >, Tp... >
+: indexed_type< I, Tp >...
+{ };
+
+/** Deduces T from the unique base indexed_type<I, T> (use in decltype only) */
+template< std::size_t I, typename T >
+type_wrap< T > type_at(indexed_type< I, T > const *);
+
+
+////////////////////  split_list  ////////////////////
+
+
+/**
+ * Split elements Tp... into two lists of (almost) equal size:
+ *
+ *   - first  : sane_typelist of the first size/2 elements
+ *   - second : sane_typelist of the remaining elements
+ */
+template< typename... Tp >
+struct split_list {
+  static constexpr std::size_t size = sizeof...(Tp);
+  static constexpr std::size_t half = size / 2;
+
+  using indexed = indexed_types< make_index_sequence< size >, Tp... >;
+
+  template< typename S, std::size_t offset >
+  struct slice;
+  template< std::size_t... I, std::size_t offset >
+  struct slice< index_sequence< I... >, offset > {
+    using type = sane_typelist<
+      typename decltype(type_at< offset + I >(static_cast< indexed const * >(nullptr)))::type...
+      >;
+  };
+
+  using first  = typename slice< make_index_sequence< half >, 0 >::type;
+  using second = typename slice< make_index_sequence< size - half >, half >::type;
+};
+
+
+////////////////////  concat_list  ////////////////////
+
+
+/**
+ * Concatenate lists (L..., all of type sane_typelist<>) to a single
+ * sane_typelist<>.
+ *
+ * Splits L... in halves (instantiation depth: log2(N)).
+ */
+template< typename... L >
+struct concat_list;
+
+template< typename L >
+struct concat_list_of;
+template< typename... L >
+struct concat_list_of< sane_typelist< L... > > {
+  using type = typename concat_list< L... >::type;
+};
+
+template< typename... L >
+struct concat_list {
+  using split = split_list< L... >;
+  using type = typename concat_list<
+    typename concat_list_of< typename split::first  >::type,
+    typename concat_list_of< typename split::second >::type
+    >::type;
+};
+template<>
+struct concat_list<> {
+  using type = sane_typelist<>;
+};
+template< typename... T0 >
+struct concat_list< sane_typelist< T0... > > {
+  using type = sane_typelist< T0... >;
+};
+template< typename... T0, typename... T1 >
+struct concat_list< sane_typelist< T0... >, sane_typelist< T1... > > {
+  using type = sane_typelist< T0..., T1... >;
+};
+
+
 ////////////////////  make_typelist  ////////////////////
 
 
 /**
- * Create a typelist by successively adding elements to the provided
+ * Provides list_type::append<T>, or list_type if T is void.
+ */
+template<typename list_type, typename T>
+struct typelist_append {
+  using type = typename list_type::template append<T>;
+};
+template<typename list_type>
+struct typelist_append<list_type, void> {
+  using type = list_type;
+};
+
+/**
+ * Create a typelist by appending the elements to the provided
  * "list_type<Tp...>".
  *
  * NOTE: this removes any void types in the list.
@@ -65,82 +242,372 @@ struct list_cat_impl<L, R> {
  * and the "_typelist_append<T, Tp...>" types to automatically unfold
  * lists of lists. (meditate a bit...)
  *
+ * Each element is appended to an empty list (resulting in a list of
+ * zero or more elements), and the resulting lists are concatenated
+ * (see concat_list).
+ *
  * Usage:
  *
  *     mpl::make_typelist< list_type<>, Tp... >::type;
  *
  * Template arguments:
  *
- *   - list_type<>: must implement the "append< Tp >" trait.
+ *   - list_type<>: sane_typelist<> type.
  *   - Tp...      : any type derived by typelist_element.
  *
  */
 template<typename list_type, typename... Tp>
-struct make_typelist;
-template<typename list_type>
-struct make_typelist<list_type> {
-  using type = list_type;
-};
-template<typename list_type, typename... Tp>
-struct make_typelist<list_type, void, Tp...> {
-  using type = typename make_typelist<list_type, Tp...>::type;
-};
-template<typename list_type, typename T0, typename... Tp>
-struct make_typelist<list_type, T0, Tp...> {
-  using type = typename make_typelist<typename list_type::template append<T0>, Tp...>::type;
+struct make_typelist {
+  using type = typename concat_list<
+    list_type,
+    typename typelist_append< sane_typelist<>, Tp >::type...
+    >::type;
 };
 
 
 ////////////////////  make_filtered_list  ////////////////////
 
 
-template<typename list_type, typename condition_type, typename... Args>
-struct make_filtered_list;
-
-template<typename list_type, typename condition_type, typename... Args>
-struct make_filtered_list<list_type, condition_type, void, Args...> {
+/**
+ * Provides sane_typelist<T> if condition_type::filter<T> holds,
+ * sane_typelist<> otherwise (or if T is void).
+ */
+template<typename condition_type, typename T>
+struct filtered_element {
+  using type = typename std::conditional<
+    condition_type::template filter<T>::type::value,
+    sane_typelist<T>,
+    sane_typelist<>
+    >::type;
+};
+template<typename condition_type>
+struct filtered_element<condition_type, void> {
   /* filter out "void" list member */
-  using type = typename make_filtered_list<list_type, condition_type, Args...>::type;
+  using type = sane_typelist<>;
 };
 
-template<typename list_type, typename condition_type, typename Head, typename... Args>
-struct make_filtered_list<list_type, condition_type, Head, Args...> {
-  using type = typename make_filtered_list<
-    typename std::conditional<
-      condition_type::template filter<Head>::type::value,
-      typename list_type::template push_back<Head>,
-      list_type
-      >::type,
-    condition_type,
-    Args...
+template<typename list_type, typename condition_type, typename... Args>
+struct make_filtered_list {
+  using type = typename concat_list<
+    list_type,
+    typename filtered_element<condition_type, Args>::type...
     >::type;
 };
 
-template<typename list_type, typename condition_type>
-struct make_filtered_list<list_type, condition_type> {
-  using type = list_type;
+
+////////////////////  make_unique_list  ////////////////////
+
+
+/**
+ * Inherits type_wrap<T> for each element (Tp..., which must be
+ * distinct). Membership is tested by std::is_base_of<>, without
+ * recursion.
+ */
+template<typename... Tp>
+struct type_set
+: type_wrap<Tp>...
+{ };
+
+template<typename set_type>
+struct filter_not_in_set {
+  template<typename Tf>
+  using filter = std::integral_constant< bool, !std::is_base_of< type_wrap<Tf>, set_type >::value >;
 };
 
+/**
+ * Provides a list of the elements Tp..., holding at most one element
+ * of identical type (first occurrence).
+ *
+ * Splits Tp... in halves: unique(first) is concatenated with the
+ * elements of unique(second) not contained in unique(first)
+ * (instantiation depth: log2(N)).
+ */
+template<typename... Tp>
+struct unique_list;
+
+template<typename L>
+struct unique_list_of;
+template<typename... Tp>
+struct unique_list_of< sane_typelist<Tp...> > {
+  using type = typename unique_list<Tp...>::type;
+};
 
-////////////////////  make_unique_list  ////////////////////
+template<typename first_list, typename second_list>
+struct unique_list_merge;
+template<typename... T0, typename... T1>
+struct unique_list_merge< sane_typelist<T0...>, sane_typelist<T1...> > {
+  using type = typename make_filtered_list<
+    sane_typelist<T0...>,
+    filter_not_in_set< type_set<T0...> >,
+    T1...
+    >::type;
+};
 
+template<typename... Tp>
+struct unique_list {
+  using split = split_list<Tp...>;
+  using type = typename unique_list_merge<
+    typename unique_list_of< typename split::first  >::type,
+    typename unique_list_of< typename split::second >::type
+    >::type;
+};
+template<>
+struct unique_list<> {
+  using type = sane_typelist<>;
+};
+template<typename T>
+struct unique_list<T> {
+  using type = sane_typelist<T>;
+};
 
 template<typename list_type, typename... Args>
 struct make_unique_list;
+template<typename... Lp, typename... Args>
+struct make_unique_list<sane_typelist<Lp...>, Args...> {
+  using type = typename unique_list<Lp..., Args...>::type;
+};
 
-template<typename list_type>
-struct make_unique_list<list_type> {
-  using type = list_type;
+
+////////////////////  sort_list  ////////////////////
+
+
+/**
+ * Default order_type for sort_list: ascending key_type::key<T>::value.
+ *
+ * Template arguments:
+ *
+ *   - key_type: provides "key<T>", an std::integral_constant<> holding
+ *        the sort key of element T (converted to std::intmax_t).
+ */
+template<typename key_type>
+struct key_order {
+  template<typename T>
+  using key = typename key_type::template key<T>;
+
+  static constexpr bool less(std::intmax_t a, std::intmax_t b) {
+    return a < b;
+  }
+};
+
+/**
+ * Keys (order_type::key<T>::value) of all elements Tp, in a constexpr
+ * array. The last element of value[] is a placeholder (no zero-size
+ * arrays).
+ */
+template<typename order_type, typename... Tp>
+struct key_array {
+  static constexpr std::size_t size = sizeof...(Tp);
+  static constexpr std::intmax_t value[size + 1] = {
+    static_cast<std::intmax_t>(order_type::template key<Tp>::value)..., 0
+  };
+};
+template<typename order_type, typename... Tp>
+constexpr std::intmax_t key_array<order_type, Tp...>::value[];
+
+/**
+ * Binary search (constexpr recursion depth: log2(N)) on a key array,
+ * sorted by order_type::less().
+ */
+template<typename order_type>
+struct key_search {
+  /** Number of keys in keys[lo..hi) ordered before k */
+  static constexpr std::size_t lower_bound(const std::intmax_t * keys, std::size_t lo, std::size_t hi, std::intmax_t k) {
+    return (lo == hi) ? lo :
+      order_type::less(keys[lo + (hi - lo) / 2], k) ?
+      lower_bound(keys, lo + (hi - lo) / 2 + 1, hi, k) :
+      lower_bound(keys, lo, lo + (hi - lo) / 2, k);
+  }
+
+  /** Number of keys in keys[lo..hi) not ordered after k */
+  static constexpr std::size_t upper_bound(const std::intmax_t * keys, std::size_t lo, std::size_t hi, std::intmax_t k) {
+    return (lo == hi) ? lo :
+      !order_type::less(k, keys[lo + (hi - lo) / 2]) ?
+      upper_bound(keys, lo + (hi - lo) / 2 + 1, hi, k) :
+      upper_bound(keys, lo, lo + (hi - lo) / 2, k);
+  }
+};
+
+/**
+ * Provides sane_typelist<> of the elements at indices I... in the
+ * (unique) indexed_type<> bases of indexed.
+ */
+template<typename indexed, typename S>
+struct indexed_list;
+template<typename indexed, std::size_t... I>
+struct indexed_list< indexed, index_sequence< I... > > {
+  using type = sane_typelist<
+    typename decltype(type_at< I >(static_cast< indexed const * >(nullptr)))::type...
+    >;
+};
+
+/**
+ * Merge two lists (sorted by order_type), elements of first_list
+ * before equal elements of second_list (stable).
+ *
+ * The merged position of each element is its index in its own list,
+ * plus the number of elements of the other list ordered before it
+ * (see key_search). No recursion on the list elements.
+ */
+template<typename order_type, typename first_list, typename second_list>
+struct merge_sorted_list;
+template<typename order_type, typename... T0, typename... T1>
+struct merge_sorted_list< order_type, sane_typelist<T0...>, sane_typelist<T1...> >
+{
+  using keys0 = key_array<order_type, T0...>;
+  using keys1 = key_array<order_type, T1...>;
+  using search = key_search<order_type>;
+
+  template<typename S0, typename S1>
+  struct merge;
+  template<std::size_t... I0, std::size_t... I1>
+  struct merge< index_sequence< I0... >, index_sequence< I1... > > {
+    using indexed = indexed_types<
+      index_sequence<
+        (I0 + search::lower_bound(keys1::value, 0, keys1::size, keys0::value[I0]))...,
+        (I1 + search::upper_bound(keys0::value, 0, keys0::size, keys1::value[I1]))...
+        >,
+      T0..., T1...
+      >;
+    using type = typename indexed_list< indexed, make_index_sequence< sizeof...(T0) + sizeof...(T1) > >::type;
+  };
+
+  using type = typename merge<
+    make_index_sequence< sizeof...(T0) >,
+    make_index_sequence< sizeof...(T1) >
+    >::type;
 };
-template<typename list_type, typename Head, typename... Args>
-struct make_unique_list<list_type, Head, Args...> {
-  using type = typename make_unique_list<
-    typename std::conditional<
-      list_type::template contains<Head>::value,
-      list_type,
-      typename list_type::template push_back<Head>
-      >::type,
-    Args...>::type;
+
+/**
+ * Provides a list of the elements Tp..., sorted by order_type (stable
+ * merge sort, instantiation depth: log2(N)).
+ *
+ * Template arguments:
+ *
+ *   - order_type: provides "key<T>" (see key_order), and a constexpr
+ *        function "less(std::intmax_t a, std::intmax_t b)" (strict
+ *        weak ordering on the keys).
+ */
+template<typename order_type, typename... Tp>
+struct sort_list;
+
+template<typename order_type, typename L>
+struct sort_list_of;
+template<typename order_type, typename... Tp>
+struct sort_list_of< order_type, sane_typelist<Tp...> > {
+  using type = typename sort_list<order_type, Tp...>::type;
+};
+
+template<typename order_type, typename... Tp>
+struct sort_list {
+  using split = split_list<Tp...>;
+  using type = typename merge_sorted_list<
+    order_type,
+    typename sort_list_of< order_type, typename split::first  >::type,
+    typename sort_list_of< order_type, typename split::second >::type
+    >::type;
+};
+template<typename order_type>
+struct sort_list<order_type> {
+  using type = sane_typelist<>;
+};
+template<typename order_type, typename T>
+struct sort_list<order_type, T> {
+  using type = sane_typelist<T>;
+};
+
+
+////////////////////  group_list  ////////////////////
+
+
+/**
+ * Provides a list of lists: the elements Tp... grouped by equal keys
+ * (order_type::key<T>::value, see sort_list). The groups are ordered
+ * by key, the elements in a group keep their order in Tp....
+ *
+ * The elements are sorted, and the sorted list is sliced at the
+ * indices where the key changes.
+ */
+template<typename order_type, typename... Tp>
+struct group_list;
+
+template<typename order_type, typename sorted_list>
+struct group_sorted_list;
+template<typename order_type, typename... Tp>
+struct group_sorted_list< order_type, sane_typelist<Tp...> >
+{
+  using keys = key_array<order_type, Tp...>;
+  using indexed = indexed_types< make_index_sequence< sizeof...(Tp) >, Tp... >;
+
+  /** true if a group starts at index i */
+  static constexpr bool group_start(std::size_t i) {
+    return (i == 0) || order_type::less(keys::value[i - 1], keys::value[i]);
+  }
+
+  struct filter_group_start {
+    template<typename T>
+    using filter = std::integral_constant< bool, group_start(T::value) >;
+  };
+
+  template<std::size_t offset, typename S>
+  struct offset_index_sequence;
+  template<std::size_t offset, std::size_t... I>
+  struct offset_index_sequence< offset, index_sequence< I... > > {
+    using type = index_sequence< (offset + I)... >;
+  };
+
+  /** elements [first..last) */
+  template<std::size_t first, std::size_t last>
+  using slice = typename indexed_list<
+    indexed,
+    typename offset_index_sequence< first, make_index_sequence< last - first > >::type
+    >::type;
+
+  template<typename starts_list>
+  struct groups;
+  template<typename... S>
+  struct groups< sane_typelist< S... > > {
+    using indexed_starts = indexed_types<
+      make_index_sequence< sizeof...(S) + 1 >,
+      S..., std::integral_constant< std::size_t, sizeof...(Tp) >
+      >;
+
+    template<typename G>
+    struct group;
+    template<std::size_t... G>
+    struct group< index_sequence< G... > > {
+      using type = sane_typelist<
+        slice<
+          decltype(type_at< G     >(static_cast< indexed_starts const * >(nullptr)))::type::value,
+          decltype(type_at< G + 1 >(static_cast< indexed_starts const * >(nullptr)))::type::value
+          >...
+        >;
+    };
+
+    using type = typename group< make_index_sequence< sizeof...(S) > >::type;
+  };
+
+  template<typename S>
+  struct start_indices;
+  template<std::size_t... I>
+  struct start_indices< index_sequence< I... > > {
+    using type = typename make_filtered_list<
+      sane_typelist<>,
+      filter_group_start,
+      std::integral_constant< std::size_t, I >...
+      >::type;
+  };
+
+  using type = typename groups<
+    typename start_indices< make_index_sequence< sizeof...(Tp) > >::type
+    >::type;
+};
+
+template<typename order_type, typename... Tp>
+struct group_list {
+  using type = typename group_sorted_list<
+    order_type,
+    typename sort_list<order_type, Tp...>::type
+    >::type;
 };
 
 
@@ -169,15 +636,16 @@ for_each(std::tuple<Tp...> & t)
 ////////////////////  for_each_impl  ////////////////////
 
 
+/**
+ * Calls cmd_type::command<T>() for each element in Args..., in list
+ * order (pack expansion in a braced initializer list, which
+ * guarantees left-to-right evaluation).
+ */
 template<typename cmd_type, typename... Args>
 struct for_each_impl {
-  static void command() { }
-};
-template<typename cmd_type, typename Head, typename... Args>
-struct for_each_impl<cmd_type, Head, Args...> {
   static void command() {
-    cmd_type::template command<Head>();
-    for_each_impl<cmd_type, Args...>::command();
+    using expand = int[];
+    (void)expand{ 0, (cmd_type::template command<Args>(), 0)... };
   }
 };
 
@@ -187,14 +655,7 @@ struct for_each_impl<cmd_type, Head, Args...> {
 /** uses std::is_same<> */
 template<typename T, typename... Args>
 struct contains_impl {
-  static constexpr bool value = false;
-};
-template<typename T, typename Head, typename... Args>
-struct contains_impl<T, Head, Args...>
-{
-  static constexpr bool value =
-    ( std::is_same<T, Head>::value ||
-      contains_impl<T, Args...>::value );
+  static constexpr bool value = any_of< std::is_same<T, Args>::value... >::value;
 };
 
 
@@ -204,14 +665,7 @@ struct contains_impl<T, Head, Args...>
 /** uses std::is_base_of<> */
 template<typename T, typename... Args>
 struct contains_derived_from_impl {
-  static constexpr bool value = false;
-};
-template<typename T, typename Head, typename... Args>
-struct contains_derived_from_impl<T, Head, Args...>
-{
-  static constexpr bool value =
-    ( std::is_base_of<T, Head>::value ||
-      contains_derived_from_impl<T, Args...>::value );
+  static constexpr bool value = any_of< std::is_base_of<T, Args>::value... >::value;
 };
 
 
@@ -221,14 +675,7 @@ struct contains_derived_from_impl<T, Head, Args...>
 /** uses std::is_base_of<> */
 template<typename T, typename... Args>
 struct all_derived_from_impl {
-  static constexpr bool value = true;
-};
-template<typename T, typename Head, typename... Args>
-struct all_derived_from_impl<T, Head, Args...>
-{
-  static constexpr bool value =
-    ( std::is_base_of<T, Head>::value &&
-      all_derived_from_impl<T, Args...>::value );
+  static constexpr bool value = all_of< std::is_base_of<T, Args>::value... >::value;
 };
 
 
@@ -294,11 +741,7 @@ struct unique_check_impl {
  */
 template< typename... Tp >
 struct all_true {
-  static constexpr bool value = true;
-};
-template< typename Head, typename... Args >
-struct all_true< Head, Args... > {
-  static constexpr bool value = Head::value && all_true< Args... >::value;
+  static constexpr bool value = all_of< Tp::value... >::value;
 };
 
 
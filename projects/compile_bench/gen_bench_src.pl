@@ -0,0 +1,143 @@
+#!/usr/bin/perl
+
+#
+# creates synthetic compile-time benchmark sources.
+#
+# The workload and the number of elements are taken from the output
+# file name: "<workload>_<N>.cpp". Available workloads:
+#
+#   typelist_filter_unique : typelist<> of N elements (N/2 distinct),
+#                            reduced by filter_unique
+#
+#   reglist_merged_regmask : reglist<> of N regmask<> (four per
+#                            register), merged_regmask<Treg> of every
+#                            register
+#
+#   reglist_reset_to       : make_reglist<>::reset_to() on a resource
+#                            list of N elements (regmask<> and other
+#                            typelist elements)
+#
+#   vector_table           : vector_table<> (make_vector_table) on a
+#                            resource list of N elements (irq_handler<>
+#                            for all irq channels, regmask<> for the rest)
+#
+# usage: gen_bench_src.pl <output_files>...
+#
+
+use File::Spec::Functions qw(splitpath);
+use strict;
+use warnings FATAL => qw( all );
+
+my $header = <<'EOF';
+/*
+ * Generated by gen_bench_src.pl, do not edit.
+ *
+ * workload : %s
+ * elements : %d
+ */
+
+EOF
+
+# registers are placed outside the bit-band region, in order to
+# benchmark the generic (load/store) code path.
+my $reg_base = 0x60000000;
+
+sub reg_decl
+{
+  my $num_regs = shift;
+  my $text = '';
+  for my $r (0 .. $num_regs - 1) {
+    $text .= sprintf("using R%d = reg< uint32_t, 0x%08x, rw, 0 >;\n", $r, $reg_base + 4 * $r);
+  }
+  return $text . "\n";
+}
+
+# regmask<> number i: four regmasks per register, on distinct bits
+sub regmask_name
+{
+  my $i = shift;
+  return sprintf("regmask< R%d, 0x%x, 0x%x >", int($i / 4), 1 << ($i % 4), 1 << ($i % 4));
+}
+
+sub list_decl
+{
+  my $name = shift;
+  my $type = shift;
+  return "using $name = $type<\n  " . join(",\n  ", @_) . "\n  >;\n\n";
+}
+
+my %workload = (
+  typelist_filter_unique => sub {
+    my $n = shift;
+    my $distinct = int(($n + 1) / 2);
+    my $text = "#include <typelist.hpp>\n\nusing namespace mptl;\n\n";
+    $text .= "template<int N> struct element : typelist_element { };\n\n";
+    $text .= list_decl('list', 'typelist', map { "element< " . ($_ % $distinct) . " >" } (0 .. $n - 1));
+    $text .= "static_assert(list::size == $n, \"\");\n";
+    $text .= "static_assert(list::filter_unique::size == $distinct, \"\");\n\n";
+    $text .= "int main() { return 0; }\n";
+    return $text;
+  },
+
+  reglist_merged_regmask => sub {
+    my $n = shift;
+    my $num_regs = int(($n + 3) / 4);
+    my $text = "#include <register.hpp>\n\nusing namespace mptl;\n\n";
+    $text .= reg_decl($num_regs);
+    $text .= list_decl('list', 'reglist', map { regmask_name($_) } (0 .. $n - 1));
+    for my $r (0 .. $num_regs - 1) {
+      my $bits = ($r == $num_regs - 1 && $n % 4) ? (1 << ($n % 4)) - 1 : 0xf;
+      $text .= sprintf("static_assert(list::merged_regmask< R%d >::set_mask == 0x%x, \"\");\n", $r, $bits);
+    }
+    $text .= "\nint main() { return 0; }\n";
+    return $text;
+  },
+
+  reglist_reset_to => sub {
+    my $n = shift;
+    my $num_masks = $n - int($n / 4);
+    my $text = "#include <register.hpp>\n\nusing namespace mptl;\n\n";
+    $text .= reg_decl(int(($num_masks + 3) / 4));
+    $text .= "template<int N> struct element : typelist_element { };\n\n";
+    my @elements;
+    my $m = 0;
+    for my $i (0 .. $n - 1) {
+      push @elements, ($i % 4 == 3) ? "element< $i >" : regmask_name($m++);
+    }
+    $text .= list_decl('resources', 'typelist', @elements);
+    $text .= "int main()\n{\n  make_reglist< resources >::reset_to();\n  return 0;\n}\n";
+    return $text;
+  },
+
+  vector_table => sub {
+    my $n = shift;
+    my $text = "#include <arch/vector_table.hpp>\n#include <register.hpp>\n\nusing namespace mptl;\n\n";
+    $text .= "static const uint32_t stack_top = 0;\n";
+    $text .= "static void default_isr(void) { }\n\n";
+    $text .= "template<int N> void isr(void) { }\n\n";
+    my $num_handlers = $n < irq_channels() ? $n : irq_channels();
+    $text .= reg_decl(int(($n - $num_handlers + 3) / 4));
+    my @elements = map { "irq_handler< irq_base< $_ >, isr< $_ > >" } (0 .. $num_handlers - 1);
+    push @elements, map { regmask_name($_) } (0 .. $n - $num_handlers - 1);
+    $text .= list_decl('resources', 'typelist', @elements);
+    $text .= "using vt = vector_table< &stack_top, resources, default_isr >;\n\n";
+    $text .= "int main()\n{\n  auto value = vt::value;\n  return value.isr_vector[0] == nullptr;\n}\n";
+    return $text;
+  },
+);
+
+# irq channels of OPENMPTL_ARCH (see Makefile)
+sub irq_channels { return 82; }
+
+while (my $outfile = shift @ARGV) {
+  my (undef, undef, $file) = splitpath($outfile);
+  die "Invalid output file name: $file\n" unless($file =~ /^(\w+)_(\d+)\.cpp$/);
+  my ($name, $n) = ($1, $2);
+  die "Unknown workload: $name\n" unless(exists($workload{$name}));
+
+  print STDERR "Creating output file: $outfile\n";
+  open(OUTFILE, ">$outfile") || die;
+  printf OUTFILE $header, $name, $n;
+  print OUTFILE $workload{$name}->($n);
+  close(OUTFILE);
+}
@@ -0,0 +1,128 @@
+/*
+ * OpenMPTL - C++ Microprocessor Template Library
+ *
+ * Copyright (C) 2012-2017 Axel Burri <axel@tty0.ch>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * Run a command (the compiler), and print its resource usage as
+ * comma separated values:
+ *
+ *     <status>,<wall_s>,<user_s>,<sys_s>,<maxrss_kb>
+ *
+ * status is "ok" if the command exited with zero, "fail" otherwise.
+ * maxrss_kb is the peak resident set size of the largest process
+ * (e.g. cc1plus for g++, which is a child of the compiler driver).
+ *
+ * usage: measure [-m <mem_kb>] [-t <cpu_s>] <logfile> <command> [<args>...]
+ *
+ *   -m  limit the address space of the command (and its children)
+ *   -t  limit the cpu time of the command (and its children)
+ *
+ * stdout and stderr of the command are redirected to logfile.
+ *
+ * NOTE: the limits apply to each process separately, which is what we
+ * want for a compiler driver spawning a single compiler process.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+static double seconds(struct timeval const & tv)
+{
+  return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+static void set_limit(int resource, rlim_t value)
+{
+  struct rlimit rl = { value, value };
+  if(setrlimit(resource, &rl) < 0)
+    std::perror("setrlimit");
+}
+
+int main(int argc, char * argv[])
+{
+  long mem_kb = 0;
+  long cpu_s = 0;
+  int opt;
+
+  /* "+": stop at the first non-option (the logfile) */
+  while((opt = getopt(argc, argv, "+m:t:")) != -1) {
+    switch(opt) {
+    case 'm': mem_kb = std::atol(optarg); break;
+    case 't': cpu_s  = std::atol(optarg); break;
+    default:  argc = 0;
+    }
+  }
+  if(argc - optind < 2) {
+    std::fprintf(stderr, "usage: %s [-m <mem_kb>] [-t <cpu_s>] <logfile> <command> [<args>...]\n", argv[0]);
+    return 2;
+  }
+  char const * logfile = argv[optind];
+  char ** command = &argv[optind + 1];
+
+  auto start = std::chrono::steady_clock::now();
+
+  pid_t pid = fork();
+  if(pid < 0) {
+    std::perror("fork");
+    return 2;
+  }
+  if(pid == 0) {
+    if(mem_kb > 0)
+      set_limit(RLIMIT_AS, static_cast<rlim_t>(mem_kb) * 1024);
+    if(cpu_s > 0)
+      set_limit(RLIMIT_CPU, static_cast<rlim_t>(cpu_s));
+
+    int fd = open(logfile, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(fd < 0) {
+      std::perror(logfile);
+      _exit(127);
+    }
+    dup2(fd, STDOUT_FILENO);
+    dup2(fd, STDERR_FILENO);
+    close(fd);
+    execvp(command[0], command);
+    std::perror(command[0]);
+    _exit(127);
+  }
+
+  int status;
+  struct rusage ru;
+  if(wait4(pid, &status, 0, &ru) < 0) {
+    std::perror("wait4");
+    return 2;
+  }
+
+  std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start;
+  bool ok = WIFEXITED(status) && (WEXITSTATUS(status) == 0);
+
+  /* the rusage of the child includes its waited-for children */
+  struct rusage ru_children;
+  getrusage(RUSAGE_CHILDREN, &ru_children);
+  long maxrss = ru.ru_maxrss > ru_children.ru_maxrss ? ru.ru_maxrss : ru_children.ru_maxrss;
+
+  std::printf("%s,%.3f,%.3f,%.3f,%ld\n", ok ? "ok" : "fail",
+              wall.count(), seconds(ru.ru_utime), seconds(ru.ru_stime), maxrss);
+
+  return 0;
+}
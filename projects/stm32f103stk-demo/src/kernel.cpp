@@ -32,19 +32,24 @@
 #include <simulation.hpp>
 
 
+/* Startup budget: number of stores emitted by reset_to() in
+ * Kernel::init(). Increase deliberately when adding resources.
+ */
+static_assert(Kernel::resources_report::numof_stores <= 14, "startup sequence exceeds its store budget");
+
 //#define DEBUG_ASSERT_REGISTER_AGAINST_FIXED_VALUES
 #ifdef DEBUG_ASSERT_REGISTER_AGAINST_FIXED_VALUES
-/* Check the shared registers against fixed values.
- * You can always explicitely set the registers using this notation.
- * NOTE: combined_type<reg_shared_group<X>> is of type reg_shared<...>
+/* Check the register values written by reset_to() against fixed
+ * values (see reglist::report). Print the values of all registers
+ * in simulation using Kernel::resources_report::dump().
  */
 #include <arch/reg/rcc.hpp>
 #include <arch/reg/gpio.hpp>
 
-static_assert(mptl::make_reglist< Kernel::resources >::merged_regmask< mptl::RCC::APB1ENR   >::set_mask == 0x18020000, "apb1enr");
-static_assert(mptl::make_reglist< Kernel::resources >::merged_regmask< mptl::RCC::APB2ENR   >::set_mask == 0x0000121c, "apb2enr");
-static_assert(mptl::make_reglist< Kernel::resources >::merged_regmask< mptl::GPIO<'C'>::CRL >::set_mask == 0x34000000, "crl");
-static_assert(mptl::make_reglist< Kernel::resources >::merged_regmask< mptl::GPIO<'C'>::CRH >::set_mask == 0x00020383, "crh");
+static_assert(Kernel::resources_report::value(mptl::RCC::APB1ENR::addr)   == 0x18020000, "apb1enr");
+static_assert(Kernel::resources_report::value(mptl::RCC::APB2ENR::addr)   == 0x0000121c, "apb2enr");
+static_assert(Kernel::resources_report::value(mptl::GPIO<'C'>::CRL::addr) == 0x34444444, "crl");
+static_assert(Kernel::resources_report::value(mptl::GPIO<'C'>::CRH::addr) == 0x44424383, "crh");
 
 #endif // DEBUG_ASSERT_REGISTER_AGAINST_FIXED_VALUES
 
@@ -105,6 +110,9 @@ void Kernel::run(void)
   terminal.open();
   terminal.tx_stream << "\r\n\r\nWelcome to OpenMPTL terminal console!\r\n# " << poorman::flush;
 
+  /* configure SPI for the LCD (see terminal_hooks::nrf_test) */
+  lcd::enable();
+
   /* start kernel loop */
   fsm_list::start();
   while(1)
@@ -151,7 +159,6 @@ void Kernel::run(void)
     cycle     = cycle_counter.get();
 
     /* update screen */
-    lcd::enable();
     Screen::update();
 
     SIM_RELAX; // sleep a bit (don't eat up all cpu power)
@@ -111,6 +111,9 @@ struct Kernel
     usart_cfg,
     terminal_type::resources
   >;
+
+  /** Register writes of reset_to() in init() (see reglist::report) */
+  using resources_report = mptl::make_reglist< resources >::report<>;
 };
 
 #endif // KERNEL_HPP_INCLUDED
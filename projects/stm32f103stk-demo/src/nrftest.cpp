@@ -28,8 +28,10 @@ void nrf_test::run(poorman::ostream<char> & cout) {
 
   using namespace poorman;
   using nrf = Kernel::nrf;
+  using lcd = Kernel::lcd;
 
-  nrf::enable();
+  /* SPI bus is shared with the LCD: switch configuration */
+  nrf::enable_from< lcd::spi_cfg >();
 
   c = nrf::read_register(nrf::dev_register::status);
   cout << "status=0x" << c << endl;
@@ -44,6 +46,8 @@ void nrf_test::run(poorman::ostream<char> & cout) {
   nrf::dev_address r_addr;
   nrf::read_address_register(nrf::dev_register::rx_addr_p0, r_addr);
   cout << "rx_addr_p0=0x" << r_addr.buf[0] << r_addr.buf[1] << r_addr.buf[2] << r_addr.buf[3] << r_addr.buf[4] << endl;
+
+  lcd::enable_from< nrf::spi_cfg >();
 }
 
 } // namespace terminal_hooks
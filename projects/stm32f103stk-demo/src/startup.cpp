@@ -54,6 +54,10 @@ int main(void)
   // vector_table::dump_vector();
 #endif
 
+#ifdef DUMP_REGLIST_REPORT
+  Kernel::resources_report::dump();
+#endif
+
   std::cout << "*** stm32f103stk demo: starting simulation..." << std::endl;
   Kernel::reset_isr();
 }
@@ -0,0 +1,62 @@
+/*
+ * OpenMPTL - C++ Microprocessor Template Library
+ *
+ * Copyright (C) 2012-2017 Axel Burri <axel@tty0.ch>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * Compile-only check (not linked): access_policy::atomic on the
+ * target. The simulation replaces the LDREX/STREX retry loop (see
+ * arch/exclusive.hpp) by __atomic builtins, so the unittests do not
+ * cover it. The Makefile checks the generated assembly for exclusive
+ * loads/stores of all access widths.
+ */
+
+#include "../src/kernel.hpp"
+
+using namespace mptl;
+
+using USARTx = Kernel::usart::USARTx;
+
+/* single bit: bit-band store (see bitband_periph::prefer_bitop_write) */
+void check_usart_tx_interrupt(void)
+{
+  Kernel::usart::enable_tx_interrupt();
+  Kernel::usart::disable_tx_interrupt();
+}
+
+/* interrupt enable bits known at runtime: LDREX/STREX retry loop */
+void check_usart_interrupt(bool rxne, bool txe)
+{
+  Kernel::usart::enable_interrupt(rxne, txe);
+  Kernel::usart::disable_interrupt(rxne, txe);
+}
+
+/* mixed set/clear bits: LDREX/STREX retry loop */
+void check_usart_cr1(void)
+{
+  USARTx::CR1::atomic_set< regval< USARTx::CR1::TXEIE, 1 >, regval< USARTx::CR1::RXNEIE, 0 > >();
+}
+
+/* registers not covered by the bit-band region: ldrex{,h,b}, strex{,h,b} */
+using word_reg     = reg< uint32_t, 0xe0001000, rw >;
+using halfword_reg = reg< uint16_t, 0xe0001004, rw >;
+using byte_reg     = reg< uint8_t,  0xe0001008, rw >;
+
+void check_word(void)     { regmask< word_reg,     0x00000001, 0x00000003 >::set< access_policy::atomic >(); }
+void check_halfword(void) { regmask< halfword_reg, 0x0001,     0x0003     >::set< access_policy::atomic >(); }
+void check_byte(void)     { regmask< byte_reg,     0x01,       0x03       >::set< access_policy::atomic >(); }
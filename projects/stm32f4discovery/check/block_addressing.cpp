@@ -0,0 +1,47 @@
+/*
+ * OpenMPTL - C++ Microprocessor Template Library
+ *
+ * Copyright (C) 2012-2017 Axel Burri <axel@tty0.ch>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * Compile-only check (not linked): CONFIG_REGISTER_BLOCK_ADDRESSING
+ * on the target. The simulation does not use reg_block, so the
+ * unittests do not cover it. The Makefile builds this file with
+ * CONFIG_REGISTER_BLOCK_ADDRESSING defined, and checks the generated
+ * assembly for a single base address load (literal pool) and stores
+ * relative to the base register.
+ *
+ * NOTE: keep this the only function in the file, and use small store
+ * values (immediates): all literal pool entries are counted as
+ * address loads.
+ */
+
+#include <arch/reg/gpio.hpp>
+
+using namespace mptl;
+
+using GPIOx = GPIO<'D'>;
+
+void check_gpio_init(void)
+{
+  GPIOx::MODER::store(0x01);
+  GPIOx::OTYPER::store(0x02);
+  GPIOx::OSPEEDR::store(0x03);
+  GPIOx::PUPDR::store(0x04);
+  GPIOx::ODR::store(0x05);
+}
@@ -0,0 +1,146 @@
+/*
+ * OpenMPTL - C++ Microprocessor Template Library
+ *
+ * Copyright (C) 2012-2017 Axel Burri <axel@tty0.ch>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <register.hpp>
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "regdump.hpp"
+
+using namespace mptl;
+
+std::ostream & mptl::sim::regdump_ostream = unittest::regdump;
+
+using X = reg< uint32_t, 0x40000000, rw, 0 >;  /* TIM2::CR1 (arch f4), covered by bit-band region */
+using Y = reg< uint32_t, 0x00001000, rw, 0 >;  /* not covered by bit-band region */
+using F = reg< uint32_t, 0x40000010, rw_wc, 0 >;  /* TIM2::SR (arch f4), write-to-clear flags */
+
+int main()
+{
+  std::cout << "*** main ***" << std::endl;
+
+  using bit_0    = regmask< X, 0x01, 0x01 >;
+  using bits_1_2 = regmask< X, 0x06, 0x06 >;
+  using bits_4_6 = regmask< X, 0x70, 0x70 >;
+  using clr_0_1  = regmask< X, 0x00, 0x03 >;
+  using mixed    = regmask< X, 0x01, 0x03 >;
+
+  /* cost model (arch/bitband.hpp) */
+  static_assert(bit_0::bitop_set() == true, "");
+  static_assert(bits_1_2::bitop_set() == false, "");  /* bit-band: mov, 2 * str; RMW: ldr, orr, str */
+  static_assert(bits_1_2::bitop_set< access_policy::atomic >() == true, "");
+  static_assert(clr_0_1::bitop_set() == false, "");
+  static_assert(bits_4_6::bitop_set() == false, "");
+  static_assert(bits_4_6::bitop_set< access_policy::atomic >() == true, "");
+  static_assert(mixed::bitop_set< access_policy::atomic >() == false, "");
+  static_assert(regmask< Y, 0x01, 0x01 >::bitop_set< access_policy::atomic >() == false, "");
+  static_assert(regmask< F, 0x01, 0x01 >::bitop_set() == false, "");
+  static_assert(regmask< F, 0x01, 0x01 >::bitop_clear< access_policy::atomic >() == false, "");
+
+  X::store(0);
+  unittest::regdump_flush();
+
+  bit_0::set();
+  unittest::assert_access({ "::bitset()" });
+
+  bits_1_2::set();
+  unittest::assert_access({ "::load()", "::store()" });
+  assert(X::reg_value == 0x07);
+
+  bits_4_6::set();
+  unittest::assert_access({ "::load()", "::store()" });
+  assert(X::reg_value == 0x77);
+
+  X::store(0);
+  unittest::regdump_flush();
+  bits_4_6::set< access_policy::atomic >();
+  unittest::assert_access({ "::bitset()", "::bitset()", "::bitset()" });
+  assert(X::reg_value == 0x70);
+
+  X::store(0xff);
+  unittest::regdump_flush();
+  clr_0_1::set();
+  unittest::assert_access({ "::load()", "::store()" });
+  assert(X::reg_value == 0xfc);
+
+  mixed::set< access_policy::atomic >();
+  unittest::assert_access({ "::atomic()" });
+  assert(X::reg_value == 0xfd);
+
+  regbits< X, 4, 2 >::clear< access_policy::atomic >();
+  unittest::assert_access({ "::bitclear()", "::bitclear()" });
+  assert(X::reg_value == 0xcd);
+
+  bits_4_6::clear();
+  unittest::assert_access({ "::load()", "::store()" });
+  assert(X::reg_value == 0x8d);
+
+  bits_4_6::clear< access_policy::atomic >();
+  unittest::assert_access({ "::bitclear()", "::bitclear()", "::bitclear()" });
+
+  /* merged regmasks */
+  X::store(0);
+  unittest::regdump_flush();
+  reglist< regmask< X, 0x01, 0x01 >, regmask< X, 0x10, 0x10 > >::set();
+  unittest::assert_access({ "::load()", "::store()" });
+  assert(X::reg_value == 0x11);
+
+  /* write-to-clear flags: never written by bit-band stores */
+  F::store(0);
+  unittest::regdump_flush();
+  regmask< F, 0x00, 0x01 >::set();
+  unittest::assert_access({ "::load()", "::store()" });
+  regmask< F, 0x02, 0x02 >::set< access_policy::atomic >();
+  unittest::assert_access({ "::atomic()" });
+  assert(F::reg_value == 0x02);
+
+  /* reads: bit-band only on single bits */
+  assert(bit_0::test() == true);
+  unittest::assert_access({ "::bittest()" });
+  assert(bits_1_2::test() == false);
+  unittest::assert_access({ "::load()" });
+
+  /* not covered by bit-band region: atomic read-modify-write */
+  Y::store(0xf0);
+  unittest::regdump_flush();
+  regmask< Y, 0x01, 0x01 >::set< access_policy::atomic >();
+  unittest::assert_access({ "::atomic()" });
+  assert(Y::reg_value == 0xf1);
+
+  Y::atomic_set< regmask< Y, 0x02, 0x02 >, regmask< Y, 0x00, 0x10 > >();
+  unittest::assert_access({ "::atomic()" });
+  assert(Y::reg_value == 0xe3);
+
+  Y::atomic_clear< regmask< Y, 0x00, 0x03 > >();
+  unittest::assert_access({ "::atomic()" });
+  assert(Y::reg_value == 0xe0);
+
+  Y::atomic_set(0x0c, 0xc0);
+  unittest::assert_access({ "::atomic()" });
+  assert(Y::reg_value == 0x2c);
+
+#ifdef UNITTEST_MUST_FAIL
+#warning UNITTEST_MUST_FAIL: read access to a write-only register
+  reg< uint32_t, 0x00001004, wo, 0 >::atomic_set(0x01, 0x01);
+#endif
+
+  return 0;
+}
@@ -0,0 +1,73 @@
+/*
+ * OpenMPTL - C++ Microprocessor Template Library
+ *
+ * Copyright (C) 2012-2017 Axel Burri <axel@tty0.ch>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <bitflags.hpp>
+#include <cassert>
+#include <iostream>
+
+using namespace mptl;
+
+static bitflags<8>  events;
+static bitflags<40> ready;
+constexpr bitflags<8> constant_initialized;  /* fails if the constructor is not constexpr */
+
+int main()
+{
+  std::cout << "*** main ***" << std::endl;
+
+  static_assert(bitflags<1>::word_count  == 1, "");
+  static_assert(bitflags<32>::word_count == 1, "");
+  static_assert(bitflags<33>::word_count == 2, "");
+
+  assert(events.word(0) == 0);
+  assert(events.test<3>() == false);
+
+  events.set<3>();
+  events.set<7>();
+  assert(events.test<3>());
+  assert(events.test<7>());
+  assert(events.test<0>() == false);
+  assert(events.word(0) == 0x88);
+
+  events.set<3>();  /* already set */
+  assert(events.word(0) == 0x88);
+
+  events.clear<3>();
+  assert(events.test<3>() == false);
+  assert(events.word(0) == 0x80);
+
+  /* flags spanning multiple words */
+  ready.set<0>();
+  ready.set<39>();
+  assert(ready.word(0) == 0x00000001);
+  assert(ready.word(1) == 0x00000080);
+  assert(ready.test<39>());
+  ready.clear<0>();
+  assert(ready.word(0) == 0);
+  assert(ready.test<39>());
+
+#ifdef UNITTEST_MUST_FAIL
+#warning UNITTEST_MUST_FAIL: flag index out of range
+  events.set<8>();
+#endif
+
+  return 0;
+}
@@ -0,0 +1,98 @@
+/*
+ * OpenMPTL - C++ Microprocessor Template Library
+ *
+ * Copyright (C) 2012-2017 Axel Burri <axel@tty0.ch>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <register_array.hpp>
+#include <arch/nvic.hpp>
+#include <arch/reg/gpio.hpp>
+#include <cassert>
+#include <iostream>
+#include "regdump.hpp"
+
+using namespace mptl;
+
+std::ostream & mptl::sim::regdump_ostream = unittest::regdump;
+
+using ISER = reg_array< NVIC::ISER<0>, 4, 8 >;
+
+int main()
+{
+  std::cout << "*** main ***" << std::endl;
+
+  static_assert(ISER::addr(0) == 0xE000E100, "");
+  static_assert(ISER::addr(7) == 0xE000E11C, "");
+  static_assert(std::is_same< ISER::element<3>, NVIC::ISER<3>::type >::value, "");
+  static_assert(GPIO_PORTS::BSRR::addr(2) == GPIO<'C'>::BSRR::addr, "");
+  static_assert(std::is_same< GPIO_PORTS::ODR::element<8>, GPIO<'I'>::ODR::type >::value, "");
+  static_assert(std::is_same< GPIO_PORTS::BSRR::element<2>, GPIO<'C'>::BSRR::type >::value, "");  /* reg_lane::halfword */
+
+  /* runtime index accesses the register of the compile-time element */
+  volatile unsigned index = 2;
+  ISER::store(index, 0x10);
+  assert(NVIC::ISER<2>::reg_value == 0x10);
+  auto dump = unittest::regdump_flush();
+  assert(dump.size() == 1);
+  assert(dump[0].name == "NVIC::ISER2");
+  assert(dump[0].action == "::store()");
+
+  NVIC::ISER<5>::store(0x0f);
+  unittest::regdump_flush();
+  index = 5;
+  assert(ISER::load(index) == 0x0f);
+  assert(ISER::test(index, 0x02) == 0x02);
+  ISER::set(index, 0xf0, 0x0f);
+  assert(NVIC::ISER<5>::reg_value == 0xf0);
+  unittest::regdump_flush();
+
+  /* irq_channel_runtime: same accesses as irq_channel<> */
+  volatile unsigned irqn = 38;
+  irq_channel_runtime::enable(irqn);
+  assert(NVIC::ISER<1>::reg_value == (1u << 6));
+  irq_channel_runtime::disable(irqn);
+  dump = unittest::regdump_flush();
+  assert(dump.size() == 3);  /* ICER: store, dsb_isb */
+  assert(dump[1].name == "NVIC::ICER1");
+  assert(dump[2].action == "::dsb_isb()");
+
+  irq_channel< 38 >::enable();
+  irq_channel< 38 >::disable();
+  assert(unittest::regdump_count("::") == 3);
+
+  /* pin map: port index known at runtime, BSRR updates ODR */
+  volatile unsigned port = 'D' - 'A';
+  GPIO_PORTS::BSRR::store(port, 1 << 12);
+  assert(GPIO<'D'>::ODR::reg_value == (1 << 12));
+  assert(GPIO_PORTS::ODR::load(port) == (1 << 12));
+  GPIO_PORTS::BSRR::store(port, 1 << (12 + 16));
+  assert(GPIO<'D'>::ODR::reg_value == 0);
+  assert(GPIO<'D'>::BSRR::reg_value == (1u << (12 + 16)));
+  unittest::regdump_flush();
+
+#ifdef UNITTEST_MUST_FAIL
+#warning UNITTEST_MUST_FAIL: write access to a read-only register
+  GPIO_PORTS::IDR::store(port, 0);
+#endif
+
+#ifdef UNITTEST_MUST_FAIL
+#warning UNITTEST_MUST_FAIL: stride is smaller than the register size
+  reg_array< NVIC::ISER<0>, 2, 8 >::load(0);
+#endif
+
+  return 0;
+}
@@ -0,0 +1,98 @@
+/*
+ * OpenMPTL - C++ Microprocessor Template Library
+ *
+ * Copyright (C) 2012-2017 Axel Burri <axel@tty0.ch>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <register.hpp>
+#include <arch/scb.hpp>
+#include <cassert>
+#include <iostream>
+#include "regdump.hpp"
+
+using namespace mptl;
+
+std::ostream & mptl::sim::regdump_ostream = unittest::regdump;
+
+/* flag register, cleared in interrupt handlers */
+struct FLAGS
+: public reg< uint32_t, 0x40000000, rw, 0, reg_barrier::dsb >
+{
+  using FLAG_A = regbits< type, 0, 1 >;
+  using FLAG_B = regbits< type, 1, 1 >;
+  using VALUE  = regbits< type, 8, 8 >;
+};
+
+/* no barrier (default) */
+using PLAIN = reg< uint32_t, 0x40000004, rw >;
+
+int main()
+{
+  std::cout << "*** main ***" << std::endl;
+
+  static_assert(PLAIN::barrier == reg_barrier::none, "");
+  static_assert(FLAGS::barrier == reg_barrier::dsb, "");
+  static_assert(FLAGS::FLAG_A::reg_type::barrier == reg_barrier::dsb, "");
+  static_assert(SCB::VTOR::barrier == reg_barrier::dsb_isb, "");
+  static_assert(mpl::strongest_reg_barrier< PLAIN::regbits_type, FLAGS::FLAG_A, SCB::VTOR::TBLOFF >::value == reg_barrier::dsb_isb, "");
+  static_assert(mpl::strongest_reg_barrier< PLAIN::regbits_type >::value == reg_barrier::none, "");
+
+  /* store: barrier after the store */
+  unittest::regdump_flush();
+  FLAGS::store(0x300);
+  auto dump = unittest::regdump_flush();
+  assert(dump.size() == 2);
+  assert(dump[0].action.compare(0, 9, "::store()") == 0);
+  assert(dump[1].action == "::dsb()");
+
+  /* bit-band clear (e.g. clearing an interrupt flag) */
+  FLAGS::FLAG_A::set();
+  unittest::regdump_flush();
+  FLAGS::FLAG_A::clear();
+  dump = unittest::regdump_flush();
+  assert(dump.size() == 2);
+  assert(dump[0].action.compare(0, 12, "::bitclear()") == 0);
+  assert(dump[1].action == "::dsb()");
+
+  /* read-modify-write: single barrier */
+  regval< FLAGS::VALUE, 0x42 >::set();
+  assert(unittest::regdump_count("::dsb()") == 1);
+
+  /* atomic access */
+  regval< FLAGS::VALUE, 0x17 >::set<access_policy::atomic>();
+  assert(unittest::regdump_count("::dsb()") == 1);
+
+  /* loads are never followed by a barrier */
+  (void)FLAGS::load();
+  (void)FLAGS::FLAG_B::test();
+  assert(unittest::regdump_count("::dsb()") == 0);
+
+  /* registers without barrier */
+  PLAIN::store(1);
+  PLAIN::set(0xff, 0x0f);
+  assert(unittest::regdump_count("::d") == 0);
+
+  /* dsb + isb */
+  SCB::VTOR::store(0x20000000);
+  assert(unittest::regdump_count("::dsb_isb()") == 1);
+
+  /* table emission: stores through reg_access::store() */
+  reglist< regval< FLAGS::VALUE, 0x11 >, regval< PLAIN::regbits_type, 0x22 > >::reset_to< reglist_emission::table >();
+  assert(unittest::regdump_count("::dsb()") == 1);
+
+  return 0;
+}
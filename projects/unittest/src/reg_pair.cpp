@@ -0,0 +1,131 @@
+/*
+ * OpenMPTL - C++ Microprocessor Template Library
+ *
+ * Copyright (C) 2012-2017 Axel Burri <axel@tty0.ch>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <register.hpp>
+#include <cassert>
+#include <iostream>
+#include "regdump.hpp"
+
+using namespace mptl;
+
+std::ostream & mptl::sim::regdump_ostream = unittest::regdump;
+
+namespace mptl {
+  template<> struct address_map< 0x18 > { static constexpr const char * name_str = "TEST::CNTH"; };
+  template<> struct address_map< 0x1c > { static constexpr const char * name_str = "TEST::CNTL"; };
+}
+
+/*
+ * 32bit counter split into 16bit registers (as RTC::CNTH/CNTL on
+ * stm32f1), ticking once after every register read. This injects a
+ * wrap of the low half between the two reads of a pair.
+ */
+struct CNTH;
+struct CNTL;
+
+static void tick(void);
+
+struct CNTH : public reg< std::uint_fast16_t, 0x18, rw, 0x0000 >
+{
+  using regbits_type = regbits< type, 0, 16 >;
+
+  static value_type load(void) {
+    value_type value = reg::load();
+    tick();
+    return value;
+  }
+};
+
+struct CNTL : public reg< std::uint_fast16_t, 0x1c, rw, 0x0000 >
+{
+  using regbits_type = regbits< type, 0, 16 >;
+
+  static value_type load(void) {
+    value_type value = reg::load();
+    tick();
+    return value;
+  }
+};
+
+static void tick(void)
+{
+  CNTL::value_type lo = (CNTL::reg_value + 1) & 0xffff;
+  CNTL::reg_value = lo;
+  if(lo == 0)
+    CNTH::reg_value = (CNTH::reg_value + 1) & 0xffff;
+}
+
+/** Unprotected read: high half, then low half */
+static uint32_t naive_load(void)
+{
+  uint32_t hi = CNTH::load();
+  return (hi << 16) | CNTL::load();
+}
+
+using counter = reg_pair< CNTH, CNTL >;
+
+int main()
+{
+  std::cout << "*** main ***" << std::endl;
+
+  static_assert(counter::lo_width == 16, "");
+  static_assert(counter::hi_width == 16, "");
+  static_assert(counter::compose(0x1234, 0xabcd) == 0x1234abcd, "");
+
+  /* the naive read glitches backwards on wrap */
+  counter::store(0x0001ffff);
+  assert(CNTH::reg_value == 0x0001);
+  assert(CNTL::reg_value == 0xffff);
+  assert(naive_load() == 0x00010000);
+
+  /* reg_pair detects the wrap and reads again */
+  counter::store(0x0001ffff);
+  unittest::regdump_flush();
+  assert(counter::load() == 0x00020002);
+  assert(unittest::regdump_count("::load()") == 5);  /* H, L, H (changed), L, H */
+
+  /* no wrap: single read of each half, plus high check */
+  counter::store(0x00051000);
+  unittest::regdump_flush();
+  assert(counter::load() == 0x00051001);
+  assert(unittest::regdump_count("::load()") == 3);
+
+  /* monotonic timestamps across the wrap, for every position of the wrap */
+  for(uint32_t start = 0x0001fff8; start < 0x00020008; start++) {
+    counter::store(start);
+    uint32_t prev = 0;
+    for(int i = 0; i < 16; i++) {
+      uint32_t now = counter::load();
+      assert(now > prev);
+      assert(now >= start);
+      prev = now;
+    }
+  }
+
+  /* latched strategy: low half first */
+  using latched = reg_pair< CNTH, CNTL, reg_pair_read::latched >;
+  counter::store(0x00031000);
+  unittest::regdump_flush();
+  assert(latched::load() == 0x00031000);
+  assert(unittest::regdump_count("::load()") == 2);
+
+  return 0;
+}
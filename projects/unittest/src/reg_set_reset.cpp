@@ -0,0 +1,103 @@
+/*
+ * OpenMPTL - C++ Microprocessor Template Library
+ *
+ * Copyright (C) 2012-2017 Axel Burri <axel@tty0.ch>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <arch/reg/gpio.hpp>
+#include <cassert>
+#include <iostream>
+#include "regdump.hpp"
+
+using namespace mptl;
+
+std::ostream & mptl::sim::regdump_ostream = unittest::regdump;
+
+using GPIOA = GPIO<'A'>;
+using GPIOI = GPIO<'I'>;
+
+int main()
+{
+  std::cout << "*** main ***" << std::endl;
+
+  static_assert(reg_set_reset::output(GPIOA::ODR::addr), "");
+  static_assert(reg_set_reset::output(GPIOI::ODR::addr), "");
+  static_assert(reg_set_reset::output(GPIOA::IDR::addr) == false, "");
+  static_assert(reg_set_reset::output(GPIO<'I'>::base_addr + 0x400 + 0x14) == false, "");  /* out of GPIO region */
+  static_assert(reg_set_reset::set_reset(GPIOA::BSRR::addr), "");
+  static_assert(reg_set_reset::set_reset_addr(GPIOI::ODR::addr) == GPIOI::BSRR::addr, "");
+  static_assert(std::is_same< reg_set_reset::output_type< GPIOI::ODR::addr >, GPIOI::ODR >::value, "");
+
+  using ODR3 = GPIOA::ODRx<3>;
+  using ODR5 = GPIOA::ODRx<5>;
+  using ODR8 = GPIOA::ODRx<8>;
+  using ODR_lo = regmask< GPIOA::ODR, 0x0005, 0x000f >;
+
+  static_assert(ODR3::set_reset_enabled, "");
+  static_assert(ODR_lo::set_reset_enabled, "");
+  static_assert(GPIOA::MODERx<3>::set_reset_enabled == false, "");
+  static_assert(regmask< GPIOA::ODR, 0, 0 >::set_reset_enabled == false, "");
+  static_assert(regmask< GPIOA::ODR, 0x10000, 0x10000 >::set_reset_enabled == false, "");  /* reserved bits */
+
+  GPIOA::ODR::store(0x00f0);
+  assert(unittest::regdump_count("::load()") == 0);
+
+  /* single bit: BSRR store instead of bit-band access */
+  ODR3::set();
+  unittest::assert_access({ "GPIOA::BSRR::store()" });
+  assert(GPIOA::BSRR::reg_value == 0x00000008);
+  assert(GPIOA::ODR::reg_value == 0x00f8);
+
+  ODR5::clear();
+  unittest::assert_access({ "GPIOA::BSRR::store()" });
+  assert(GPIOA::BSRR::reg_value == 0x00200000);
+  assert(GPIOA::ODR::reg_value == 0x00d8);
+
+  /* multiple bits: set and reset in a single BSRR store */
+  ODR_lo::set();
+  unittest::assert_access({ "GPIOA::BSRR::store()" });
+  assert(GPIOA::BSRR::reg_value == 0x000a0005);
+  assert(GPIOA::ODR::reg_value == 0x00d5);
+
+  /* merged regmasks from reglist */
+  reglist< ODR3, ODR8, regval< ODR5, 0 > >::set();
+  unittest::assert_access({ "GPIOA::BSRR::store()" });
+  assert(GPIOA::BSRR::reg_value == 0x00200108);
+  assert(GPIOA::ODR::reg_value == 0x01dd);
+
+  reglist< ODR3, ODR8 >::clear();
+  unittest::assert_access({ "GPIOA::BSRR::store()" });
+  assert(GPIOA::ODR::reg_value == 0x00d5);
+
+  /* atomic policy: BSRR store is atomic */
+  ODR8::set< access_policy::atomic >();
+  unittest::assert_access({ "GPIOA::BSRR::store()" });
+  assert(GPIOA::ODR::reg_value == 0x01d5);
+
+  /* full coverage still results in a single ODR store */
+  regmask< GPIOA::ODR, 0x1234, 0xffffffff >::set();
+  unittest::assert_access({ "GPIOA::ODR::store()" });
+  assert(GPIOA::ODR::reg_value == 0x1234);
+
+  /* reset_to() writes the whole ODR register */
+  reglist< ODR3 >::reset_to();
+  unittest::assert_access({ "GPIOA::ODR::store()" });
+  assert(GPIOA::ODR::reg_value == 0x0008);
+
+  return 0;
+}
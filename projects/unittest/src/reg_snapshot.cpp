@@ -0,0 +1,133 @@
+/*
+ * OpenMPTL - C++ Microprocessor Template Library
+ *
+ * Copyright (C) 2012-2017 Axel Burri <axel@tty0.ch>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <register.hpp>
+#include <arch/rcc.hpp>
+#include <arch/usart.hpp>
+#include <arch/usart_stream.hpp>
+#include <fifo.hpp>
+#include <cassert>
+#include <iostream>
+#include "regdump.hpp"
+
+using namespace mptl;
+
+std::ostream & mptl::sim::regdump_ostream = unittest::regdump;
+
+using A = reg< uint32_t, 0x00, rw, 0 >;
+
+namespace mptl {
+  template<> struct address_map< 0x00 > { static constexpr const char * name_str = "TEST::A"; };
+}
+
+using A_lo  = regbits< A, 0, 8 >;
+using A_mid = regbits< A, 8, 4 >;
+using A_hi  = regbits< A, 28, 4 >;
+using A_bit = regbits< A, 12, 1 >;
+using A_mid_5 = regval< A_mid, 5 >;
+using A_mid_6 = regval< A_mid, 6 >;
+
+using B = reg< uint32_t, 0x04, rw, 0 >;
+using B0 = regbits< B, 0, 1 >;
+
+using sysclk = system_clock_hse< mhz(168) >;
+using usart2 = usart< 2, sysclk, void, void >;
+using usart_stream = usart_irq_stream< usart2, ring_buffer<char, 16>, true, true >;
+using SR = usart2::USARTx::SR;
+using DR = usart2::USARTx::DR;
+
+/** Calls the interrupt service routine of an irq_handler<> */
+struct functor_call_isr {
+  template<typename list_element_type>
+  static void command(void) {
+    list_element_type::value();
+  }
+};
+
+
+int main()
+{
+  std::cout << "*** main ***" << std::endl;
+
+  A::store(0x3000a5ff);
+  unittest::regdump_flush();
+
+  auto a = A::snapshot();
+  assert(unittest::regdump_count("::load()") == 1);
+
+  assert(a.raw() == 0x3000a5ff);
+  assert(a.get< A_lo >()  == 0xff);
+  assert(a.get< A_mid >() == 0x5);
+  assert(a.get< A_hi >()  == 0x3);
+  assert(a.get< A_bit >() == 0);
+  assert(a.test< A_mid_5 >());
+  assert(a.test< A_mid_6 >() == false);
+  assert(a.test< A_bit >() == false);
+  assert(a.test< A_lo >());              /* multi-bit regbits: any bit set */
+  assert((a.test_any< A_bit, A_mid_6 >() == false));
+  assert((a.test_any< A_bit, A_mid_5 >() == true));
+  assert((a.test_any<>() == false));
+
+  /* no further register access */
+  assert(unittest::regdump_count("::load()") == 0);
+
+  /* restricted to fields */
+  auto a_mid = A::snapshot< A_mid, A_bit >();
+  static_assert(decltype(a_mid)::covered_mask == 0x1f00, "");
+  assert(a_mid.get< A_mid >() == 0x5);
+  assert(a_mid.test< A_mid_5 >());
+
+  constexpr reg_snapshot< A, A_lo > c(0x12);
+  static_assert(c.get< A_lo >() == 0x12, "");
+  static_assert(c.test< regval< A_lo, 0x12 > >(), "");
+
+#ifdef UNITTEST_MUST_FAIL
+#warning UNITTEST_MUST_FAIL: field is not covered by the snapshot fields
+  a_mid.get< A_lo >();
+#endif
+
+#ifdef UNITTEST_MUST_FAIL
+#warning UNITTEST_MUST_FAIL: field is not of reg_type of the snapshot
+  a.test< B0 >();
+#endif
+
+  /* usart_irq_stream ISR: exactly one load of SR */
+  SR::store(SR::RXNE::value | SR::ORE::value);
+  DR::store('x');
+  unittest::regdump_flush();
+
+  usart_stream::irq_resources::for_each< functor_call_isr >();
+
+  unsigned sr_loads = 0;
+  for(auto const & e : unittest::regdump_flush()) {
+    if((e.name == "USART2::SR") && (e.action.compare(0, 8, "::load()") == 0))
+      sr_loads++;
+  }
+  assert(sr_loads == 1);
+  assert(usart_stream::irq_count == 1);
+  assert(usart_stream::irq_errors == 1);
+
+  char c_rx;
+  assert(usart_stream::rx_fifo.pop(c_rx));
+  assert(c_rx == 'x');
+
+  return 0;
+}
@@ -0,0 +1,150 @@
+/*
+ * OpenMPTL - C++ Microprocessor Template Library
+ *
+ * Copyright (C) 2012-2017 Axel Burri <axel@tty0.ch>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef UNITTEST_REGDUMP_HPP_INCLUDED
+#define UNITTEST_REGDUMP_HPP_INCLUDED
+
+/*
+ * Capture the simulation register dump (CONFIG_DUMP_REGISTER_ACCESS),
+ * allowing unit tests to check the sequence of register accesses.
+ *
+ * Usage (define regdump_ostream in the unittest source):
+ *
+ *     std::ostream & mptl::sim::regdump_ostream = unittest::regdump;
+ */
+
+#include <cassert>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace unittest {
+
+static std::stringstream regdump;
+
+struct regdump_entry {
+  std::string name;    /**< register name (from address_map<>), or address */
+  std::string action;  /**< e.g. "::load()", "::store()", "::bitset()" */
+
+  /** True for load() and bittest() accesses */
+  bool load(void) const {
+    return (action.compare(0, 6, "::load") == 0) || (action.compare(0, 11, "::bittest()") == 0);
+  }
+
+  /** True for store() (including narrow lane stores), bitset() and bitclear() accesses */
+  bool store(void) const {
+    return (action.compare(0, 7, "::store") == 0) ||
+      (action.compare(0, 10, "::bitset()") == 0) || (action.compare(0, 12, "::bitclear()") == 0);
+  }
+};
+
+/**
+ * Parse and clear the captured register dump. The dump is echoed to
+ * std::cout.
+ */
+inline std::vector<regdump_entry> regdump_flush(void) {
+  std::vector<regdump_entry> entries;
+  std::string line;
+
+  while(std::getline(regdump, line)) {
+    std::cout << line << std::endl;
+    std::istringstream ss(line);
+    regdump_entry e;
+    if(ss >> e.name >> e.action)
+      entries.push_back(e);
+  }
+  regdump.str("");
+  regdump.clear();
+  return entries;
+}
+
+/**
+ * Returns the number of accesses of given action (e.g. "::load()")
+ * in the captured register dump, and clears the dump.
+ *
+ * NOTE: a trailing "~" (store of unchanged value) is ignored.
+ */
+inline unsigned regdump_count(const std::string & action) {
+  unsigned count = 0;
+  for(auto const & e : regdump_flush()) {
+    if(e.action.compare(0, action.size(), action) == 0)
+      count++;
+  }
+  return count;
+}
+
+/**
+ * Assert the number of loads and stores (see regdump_entry) in the
+ * captured register dump, and clear the dump.
+ */
+inline void assert_count(unsigned loads, unsigned stores) {
+  unsigned l = 0, s = 0;
+  for(auto const & e : regdump_flush()) {
+    if(e.load())
+      l++;
+    if(e.store())
+      s++;
+  }
+  assert(l == loads);
+  assert(s == stores);
+}
+
+/**
+ * Assert the sequence of accesses in the captured register dump, and
+ * clear the dump. Accesses are given either by action only (e.g.
+ * "::store()"), or qualified by register name (e.g.
+ * "GPIOA::BSRR::store()").
+ */
+inline void assert_access(std::vector<std::string> accesses) {
+  std::vector<std::string> dumped;
+  for(auto const & e : regdump_flush()) {
+    std::string action = e.action.substr(0, e.action.find(')') + 1);
+    if((dumped.size() < accesses.size()) && (accesses[dumped.size()].compare(0, 2, "::") != 0))
+      action = e.name + action;
+    dumped.push_back(action);
+  }
+  assert(dumped == accesses);
+}
+
+/**
+ * Assert the register names of all stores in the captured register
+ * dump, in given order, and clear the dump.
+ */
+inline void assert_store_order(std::vector<std::string> names) {
+  std::vector<std::string> stores;
+  for(auto const & e : regdump_flush()) {
+    if(e.store())
+      stores.push_back(e.name);
+  }
+  assert(stores == names);
+}
+
+/** Store garbage to all given registers, and clear the dump */
+template<typename... Reg>
+inline void scramble(void) {
+  using expand = int[];
+  (void)expand{ 0, (Reg::store(static_cast<typename Reg::value_type>(0xa5a5a5a5)), 0)... };
+  regdump_flush();
+}
+
+} // namespace unittest
+
+#endif // UNITTEST_REGDUMP_HPP_INCLUDED
@@ -19,7 +19,6 @@
  */
 
 #include <register.hpp>
-#include <register_manip.hpp>
 #include <cassert>
 #include <iostream>
 
@@ -73,24 +72,6 @@ template<> struct address_map< 0x00001234 > { static constexpr const char * name
 
 using namespace mptl;
 
-void unittest_register_manip()
-{
-  std::cout << "*** unittest_register_manip ***" << std::endl; 
-
-  TEST::REG::reset();
-
-  experimental::reg_manip<TEST::REG> reg;
-  reg |= 0xff;
-  reg &= 0x00ffffff;
-  reg.set<TEST::REG::BITS_4_7::CONST_d>();
-  reg.store();
-  assert(TEST::REG::load() == 0x005555df);
-
-  reg.clear<TEST::REG::BITS_0_3, TEST::REG::BITS_8_31>();
-  reg.store();
-  assert(TEST::REG::load() == 0x000000d0);
-}
-
 int main()
 {
   std::cout << "*** main ***" << std::endl; 
@@ -282,7 +263,17 @@ int main()
   TEST::REG::clear<TEST::REG2::BITS_0_7>();
 #endif
 
-  unittest_register_manip(); // TODO: separate register_manip.cpp
+  /* reg_block (CONFIG_REGISTER_BLOCK_ADDRESSING) */
+  static_assert(reg_block_of< 0x40013008 >::offset == 0x008, "");
+  static_assert(reg_block_of< 0x40013008 >::type::base_addr == 0x40013000, "");
+  static_assert(reg_block_of< 0x40013ffc >::offset == 0xffc, "");
+  static_assert(std::is_same< reg_block_of< 0x40010800 >::type, reg_block_of< 0x40010c04 >::type >::value, "");
+  assert(reg_block< 0x40013000 >::base() == 0x40013000);
+
+#ifdef UNITTEST_MUST_FAIL
+#warning "UNITTEST_MUST_FAIL: base_addr is not aligned to reg_block::size"
+  reg_block< 0x40013008 >::base();
+#endif
 
   return 0;
 }
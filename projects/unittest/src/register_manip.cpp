@@ -0,0 +1,152 @@
+/*
+ * OpenMPTL - C++ Microprocessor Template Library
+ *
+ * Copyright (C) 2012-2017 Axel Burri <axel@tty0.ch>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <register.hpp>
+#include <register_manip.hpp>
+#include <cassert>
+#include <iostream>
+#include "regdump.hpp"
+
+std::ostream & mptl::sim::regdump_ostream = unittest::regdump;
+
+namespace mptl {
+
+struct TEST
+{
+  static constexpr reg_addr_t base_addr = 0x1234;
+
+  struct REG
+  : public reg< uint32_t, base_addr + 0x00, rw, 0x55555555 >
+  {
+    using type = reg< uint32_t, base_addr + 0x00, rw, 0x55555555 >;
+
+    using BITS_0_3  = regbits< type,  0,  4 >;
+    using BITS_4_7  = regbits< type,  4,  4 >;
+    using BITS_8_31 = regbits< type,  8, 24 >;
+    using CONST_d   = regval < BITS_4_7, 0xd >;
+    using BIT_0     = regval < BITS_0_3, 0x1 >;
+    using BIT_1     = regval < BITS_0_3, 0x2 >;
+  };
+
+  struct WO
+  : public reg< uint32_t, base_addr + 0x10, wo, 0x0000ff00 >
+  {
+    using type = reg< uint32_t, base_addr + 0x10, wo, 0x0000ff00 >;
+
+    using BITS_0_7  = regbits< type,  0,  8 >;
+    using BITS_8_15 = regbits< type,  8,  8 >;
+  };
+
+  using RO = reg< uint32_t, base_addr + 0x20, ro, 0x12345678 >;
+};
+
+template<> struct address_map< 0x00001234 > { static constexpr const char * name_str = "TEST::REG"; };
+template<> struct address_map< 0x00001244 > { static constexpr const char * name_str = "TEST::WO";  };
+template<> struct address_map< 0x00001254 > { static constexpr const char * name_str = "TEST::RO";  };
+
+} // namespace mptl
+
+using namespace mptl;
+
+int main()
+{
+  std::cout << "*** main ***" << std::endl;
+
+  /* constant masks, one load(), one store() */
+  TEST::REG::reset();
+  unittest::regdump_flush();
+  {
+    auto reg = reg_transaction< TEST::REG >::load();
+    reg.set(0xff);
+    reg.clear(0xff000000);
+    reg.set< TEST::REG::CONST_d >();
+    assert(reg.get() == 0x005555df);
+    assert(reg.test< TEST::REG::CONST_d >());
+    reg.store();
+  }
+  unittest::assert_count(1, 1);
+  assert(TEST::REG::load() == 0x005555df);
+  unittest::regdump_flush();
+
+  /* merged regmasks, chained calls */
+  {
+    reg_transaction< TEST::REG >::load()
+      .clear< TEST::REG::BITS_0_3, TEST::REG::BITS_8_31 >()
+      .store();
+  }
+  unittest::assert_count(1, 1);
+  assert(TEST::REG::load() == 0x000000d0);
+  unittest::regdump_flush();
+
+  /* runtime conditions on compile-time traits */
+  for(int i = 0; i < 4; i++) {
+    bool b0 = i & 1;
+    bool b1 = i & 2;
+    TEST::REG::store(0);
+    unittest::regdump_flush();
+
+    auto reg = reg_transaction< TEST::REG >::load();
+    if(b0) reg.set< TEST::REG::BIT_0 >();
+    if(b1) reg.set< TEST::REG::BITS_8_31 >(0x00abcd00);
+    reg.store();
+
+    unittest::assert_count(1, 1);
+    assert(TEST::REG::load() == ((b0 ? 0x1u : 0u) | (b1 ? 0x00abcd00u : 0u)));
+    unittest::regdump_flush();
+  }
+
+  /* set_from() on regbits */
+  {
+    auto reg = reg_transaction< TEST::REG >::from(0xffffffff);
+    reg.set_from< TEST::REG::BITS_4_7 >(0x3);
+    assert(reg.get() == 0xffffff3f);
+    reg.store();
+  }
+  unittest::assert_count(0, 1);
+  assert(TEST::REG::load() == 0xffffff3f);
+  unittest::regdump_flush();
+
+  /* write-only register: start from reset value, no load() */
+  {
+    auto reg = reg_transaction< TEST::WO >::reset();
+    reg.set_from< TEST::WO::BITS_0_7 >(0x42);
+    reg.clear< TEST::WO::BITS_8_15 >();
+    reg.store();
+  }
+  unittest::assert_count(0, 1);
+  assert(TEST::WO::reg_value == 0x00000042);
+
+#ifdef UNITTEST_MUST_FAIL
+#warning "UNITTEST_MUST_FAIL: read access to a write-only register"
+  reg_transaction< TEST::WO >::load();
+#endif
+
+#ifdef UNITTEST_MUST_FAIL
+#warning "UNITTEST_MUST_FAIL: write access to a read-only register"
+  reg_transaction< TEST::RO >::reset().store();
+#endif
+
+#ifdef UNITTEST_MUST_FAIL
+#warning "UNITTEST_MUST_FAIL: merged template arguments have different reg<> type"
+  reg_transaction< TEST::REG >::load().set< TEST::WO::BITS_0_7 >();
+#endif
+
+  return 0;
+}
@@ -0,0 +1,109 @@
+/*
+ * OpenMPTL - C++ Microprocessor Template Library
+ *
+ * Copyright (C) 2012-2017 Axel Burri <axel@tty0.ch>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#define CONFIG_REGISTER_SHADOW
+
+#include <register.hpp>
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "regdump.hpp"
+
+using namespace mptl;
+
+std::ostream & mptl::sim::regdump_ostream = unittest::regdump;
+
+using S = reg< uint32_t, 0x00002000, rw_sw, 0x44 >;
+using H = reg< uint32_t, 0x00002004, rw,    0x44 >;
+using T = reg< uint32_t, 0x40000004, rw_sw, 0 >;  /* TIM2::CR2 (arch f4), covered by bit-band region */
+
+namespace mptl {
+  template<> struct address_map< 0x2000 > { static constexpr const char * name_str = "TEST::S"; };
+  template<> struct address_map< 0x2004 > { static constexpr const char * name_str = "TEST::H"; };
+}
+
+int main()
+{
+  std::cout << "*** main ***" << std::endl;
+
+  static_assert(S::shadowed == true, "");
+  static_assert(H::shadowed == false, "");
+  static_assert(T::bitop_enabled == false, "");
+
+  using S0 = regmask< S, 0x01, 0x01 >;
+  using S4 = regmask< S, 0x00, 0x04 >;
+  using H0 = regmask< H, 0x01, 0x01 >;
+  using T0 = regmask< T, 0x01, 0x01 >;
+
+  unittest::regdump_flush();
+
+  /* load() is served from shadow (initialized to reset value) */
+  assert(S::load() == 0x44);
+  unittest::assert_access({ });
+
+  assert(H::load() == 0x44);
+  unittest::assert_access({ "::load()" });
+
+  /* read-modify-write: store() only */
+  S0::set();
+  unittest::assert_access({ "::store()" });
+  assert(S::reg_value == 0x45);
+  assert(S::load() == 0x45);
+
+  S4::clear();
+  unittest::assert_access({ "::store()" });
+  assert(S::reg_value == 0x41);
+
+  H0::set();
+  unittest::assert_access({ "::load()", "::store()" });
+
+  reglist< S0, S4, H0 >::set();
+  unittest::assert_access({ "::store()", "::load()", "::store()" });
+
+  /* store() updates the shadow */
+  S::store(0x10);
+  assert(S::load() == 0x10);
+  assert(S0::test() == false);
+  unittest::assert_access({ "::store()" });
+
+  /* no bit-band access on shadowed registers */
+  T0::set();
+  unittest::assert_access({ "::store()" });
+  assert(T::reg_value == 0x01);
+  assert(T::load() == 0x01);
+
+  /* bitset() and bitclear() keep the shadow in sync */
+  T::bitset< 4 >();
+  T::bitclear< 0 >();
+  assert(T::load() == 0x10);
+  unittest::assert_access({ "::bitset()", "::bitclear()" });
+
+  /* modifications bypassing the register access are not seen */
+  S::reg_value = 0xff;
+  assert(S::load() == 0x10);
+
+#ifdef UNITTEST_MUST_FAIL
+#warning UNITTEST_MUST_FAIL: atomic access on a shadowed register
+  S0::set< access_policy::atomic >();
+#endif
+
+  return 0;
+}
@@ -0,0 +1,98 @@
+/*
+ * OpenMPTL - C++ Microprocessor Template Library
+ *
+ * Copyright (C) 2012-2017 Axel Burri <axel@tty0.ch>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <register.hpp>
+#include <register_wait.hpp>
+#include <freq.hpp>
+#include <cassert>
+#include <iostream>
+#include "regdump.hpp"
+
+using namespace mptl;
+
+std::ostream & mptl::sim::regdump_ostream = unittest::regdump;
+
+using A = reg< uint32_t, 0x00, rw, 0 >;
+
+namespace mptl {
+  template<> struct address_map< 0x00 > { static constexpr const char * name_str = "TEST::A"; };
+}
+
+using A0 = regbits< A, 0, 1 >;
+using A1 = regbits< A, 1, 1 >;
+using A_lo_3 = regval< regbits< A, 0, 4 >, 3 >;
+
+struct sysclk_72mhz {
+  static constexpr freq_t hclk_freq = mhz(72);
+};
+
+int main()
+{
+  std::cout << "*** main ***" << std::endl;
+
+  static_assert(wait_timeout::forever().infinite, "");
+  static_assert(wait_timeout::cycles(0).infinite == false, "");
+  static_assert(wait_timeout::cycles(1000).value == 1000, "");
+  static_assert(wait_timeout::us< sysclk_72mhz >(10).value == 720, "");
+  static_assert(wait_timeout::us< sysclk_72mhz >(0).infinite == false, "");
+  static_assert(wait_timeout::us< sysclk_72mhz >(UINT32_MAX / 72).value == (UINT32_MAX / 72) * 72, "");
+
+#ifdef UNITTEST_MUST_FAIL
+#warning UNITTEST_MUST_FAIL: call to non-'constexpr' function 'static mptl::wait_timeout mptl::wait_timeout::us_overflow()'
+  static_assert(wait_timeout::us< sysclk_72mhz >(UINT32_MAX / 72 + 1).value != 0, "");
+#endif
+
+  A::store(0x03);
+  unittest::regdump_flush();
+
+  /* condition met: single poll */
+  assert(wait_until< A0 >() == wait_result::ok);
+  assert(unittest::regdump_count("::load()") == 1);
+
+  assert(wait_until< A_lo_3 >(wait_timeout::cycles(100)) == wait_result::ok);
+  assert((wait_until< reglist< A0, A1 > >() == wait_result::ok));
+  assert((wait_while< regbits< A, 2, 1 > >() == wait_result::ok));
+  unittest::regdump_flush();
+
+  /* condition not met: timeout after (cycles / poll_cycles) polls */
+  static constexpr uint32_t polls = 10;
+  assert((wait_until< regbits< A, 2, 1 > >(wait_timeout::cycles(polls * wait_timeout::poll_cycles)) == wait_result::timeout));
+  assert(unittest::regdump_count("::load()") == polls);
+
+  assert((wait_while< A1, wait_backoff::wfe >(wait_timeout::cycles(polls * wait_timeout::poll_cycles)) == wait_result::timeout));
+  assert(unittest::regdump_count("::load()") == polls);
+
+  /* short or zero timeout: single poll */
+  assert((wait_until< regbits< A, 2, 1 > >(wait_timeout::cycles(1)) == wait_result::timeout));
+  assert(unittest::regdump_count("::load()") == 1);
+
+  assert((wait_until< regbits< A, 2, 1 > >(wait_timeout::cycles(0)) == wait_result::timeout));
+  assert(unittest::regdump_count("::load()") == 1);
+  assert((wait_until< A0 >(wait_timeout::cycles(0)) == wait_result::ok));
+  assert((wait_until< regbits< A, 2, 1 > >(wait_timeout::us< sysclk_72mhz >(0)) == wait_result::timeout));
+  assert(unittest::regdump_count("::load()") == 2);
+
+  /* maximum timeout: counting polls does not overflow */
+  volatile uint32_t n = UINT32_MAX / 72 + 1;  /* runtime: saturated */
+  assert(wait_timeout::us< sysclk_72mhz >(n).value == UINT32_MAX);
+
+  return 0;
+}
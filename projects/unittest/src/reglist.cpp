@@ -21,19 +21,22 @@
 #include <register.hpp>
 #include <cassert>
 #include <iostream>
+#include "regdump.hpp"
 
 using namespace mptl;
 
-std::ostream & mptl::sim::regdump_ostream = std::cout;
+std::ostream & mptl::sim::regdump_ostream = unittest::regdump;
 
 using A = reg< uint8_t,  0x00, rw, 0 >;
 using B = reg< uint16_t, 0x04, rw, 0 >;
 using C = reg< uint8_t,  0x08, rw, 0xff >;
+using E = reg< uint8_t,  0x0c, wo, 0x80 >;
 
 namespace mptl {
   template<> struct address_map< 0x00 > { static constexpr const char * name_str = "TEST::A"; };
   template<> struct address_map< 0x04 > { static constexpr const char * name_str = "TEST::B"; };
   template<> struct address_map< 0x08 > { static constexpr const char * name_str = "TEST::C"; };
+  template<> struct address_map< 0x0c > { static constexpr const char * name_str = "TEST::E"; };
 }
 
 using A0 = regmask< A, 0x01, 0x01 >;
@@ -48,6 +51,14 @@ using C0 = regmask< C, 0x00, 0x01 >;
 using C1 = regmask< C, 0x00, 0x02 >;
 using C2 = regmask< C, 0x00, 0x04 >;
 
+using D  = reg< uint32_t, 0x40023830, rw, 0 >;  /* RCC::AHB1ENR (arch f4) */
+using D0 = regmask< D, 0x01, 0x01 >;
+
+using PWR_CR      = reg< uint32_t, 0x40007000, rw, 0 >;  /* PWR::CR (arch f4) */
+using RTC_WPR     = reg< uint32_t, 0x40002824, wo, 0 >;  /* RTC::WPR (arch f4) */
+using GPIOA_MODER = reg< uint32_t, 0x40020000, rw, 0 >;  /* GPIOA::MODER (arch f4) */
+using GPIOA_ODR   = reg< uint32_t, 0x40020014, rw, 0 >;  /* GPIOA::ODR (arch f4) */
+
 struct Dummy : typelist_element { };
 
 
@@ -123,5 +134,218 @@ int main()
   assert(B::load() == 0xf5);
   assert(C::load() == 0xf0);
 
+  /* reset_to() and set() write the registers in ascending address order */
+  unittest::regdump_flush();
+  reglist< C0, B0, A0 >::reset_to();
+  unittest::assert_store_order({ "TEST::A", "TEST::B", "TEST::C" });
+
+  reglist< B1, C1, list_A, B2 >::set();
+  unittest::assert_store_order({ "TEST::A", "TEST::B", "TEST::C" });
+
+  /* RCC registers are always written first (see arch/reg_order.hpp) */
+  reglist< C0, A0, D0, B0 >::reset_to();
+  unittest::assert_store_order({ "RCC::AHB1ENR", "TEST::A", "TEST::B", "TEST::C" });
+
+  /* PWR before the backup domain, GPIO output levels before pin modes */
+  reglist< regmask< RTC_WPR, 0xca, 0xff >, regmask< PWR_CR, 0x100, 0x100 >, D0 >::reset_to();
+  unittest::assert_store_order({ "RCC::AHB1ENR", "PWR::CR", "RTC::WPR" });
+
+  reglist< regmask< GPIOA_MODER, 0x01, 0x03 >, regmask< GPIOA_ODR, 0x01, 0x01 >, A0 >::reset_to();
+  unittest::assert_store_order({ "GPIOA::ODR", "TEST::A", "GPIOA::MODER" });
+
+  /* test() and test_any() load each register at most once */
+  A::store(0x07);
+  B::store(0x05);
+  C::store(0xf8);
+  unittest::regdump_flush();
+
+  assert((list_ABC::test() == true));
+  assert(unittest::regdump_count("::load()") == 3);
+
+  assert((reglist< A0, A1, A2, B0, B2 >::test() == true));
+  assert(unittest::regdump_count("::load()") == 2);
+
+  assert((reglist< A0, B0, B1, C0 >::test() == false));  /* B1 mismatch, C not loaded */
+  assert(unittest::regdump_count("::load()") == 2);
+
+  assert((reglist< A0, B1 >::test_any() == true));       /* A0 match, B not loaded */
+  assert(unittest::regdump_count("::load()") == 1);
+
+  assert((reglist< B1, regmask< C, 0x02, 0x02 > >::test_any() == false));
+  assert(unittest::regdump_count("::load()") == 2);
+
+  C::store(0xfa);
+  unittest::regdump_flush();
+  assert((reglist< B1, C1, C0 >::test_any() == true));    /* C0 match */
+  assert(unittest::regdump_count("::load()") == 2);
+
+  assert((reglist< B1, regmask< B, 0x05, 0x05 > >::test_any() == true));
+  assert((reglist< B1, regmask< B, 0x05, 0x05 > >::test() == false));
+  assert(unittest::regdump_count("::load()") == 2);
+
+  assert((list_empty::test() == true));
+  assert((list_empty::test_any() == false));
+  assert(unittest::regdump_count("::load()") == 0);
+
+  /* set() on regmasks covering all register bits results in a single store() */
+  using A_hi = regmask< A, 0x00, 0xf8 >;
+  using A1_0 = regmask< A, 0x00, 0x02 >;
+  using B_lo = regmask< B, 0x00ab, 0x00ff >;
+  using B_hi = regmask< B, 0xcd00, 0xff00 >;
+  static_assert(merged_regmask< A0, A1, A2, A_hi >::full_coverage == true, "");
+  static_assert(B_lo::full_coverage == false, "");
+
+  A::store(0xff);
+  B::store(0xffff);
+  unittest::regdump_flush();
+
+  regmask< A, 0x5a, 0xff >::set();
+  assert(unittest::regdump_count("::load()") == 0);
+  assert(A::reg_value == 0x5a);
+
+  A::set< A0, A2, A_hi, A1_0 >();
+  B::set< B_lo, B_hi >();
+  assert(unittest::regdump_count("::load()") == 0);
+  assert(A::reg_value == 0x05);
+  assert(B::reg_value == 0xcdab);
+
+  B::set< B_lo, B_hi >(0x1234);
+  assert(unittest::regdump_count("::load()") == 0);
+  assert(B::reg_value == 0x1234);
+
+  reglist< A2, B_hi, A_hi, A1, B_lo, A0 >::set();
+  assert(unittest::regdump_count("::load()") == 0);
+  assert(A::reg_value == 0x07);
+  assert(B::reg_value == 0xcdab);
+
+  /* full coverage on a write-only register: store() only, no load() */
+  regmask< E, 0x5a, 0xff >::set();
+  assert(unittest::regdump_count("::load()") == 0);
+  assert(E::reg_value == 0x5a);
+
+  E::set< regmask< E, 0x0f, 0x0f >, regmask< E, 0xa0, 0xf0 > >();
+  assert(E::reg_value == 0xaf);
+  E::set< regmask< E, 0x00, 0xff > >(0x42);
+  assert(E::reg_value == 0x42);
+  regmask< E, 0x5a, 0xff >::clear();
+  assert(unittest::regdump_count("::load()") == 0);
+  assert(E::reg_value == 0x00);
+
+  /* partial coverage still results in a read-modify-write */
+  reglist< A_hi, B_lo >::set();
+  assert(unittest::regdump_count("::load()") == 2);
+
+  /* apply<write_strategy>() */
+  using E0 = regmask< E, 0x01, 0x01 >;
+
+  static_assert(mpl::auto_write_strategy< merged_regmask< A_hi, A1_0, A0, A2 > >::value == write_strategy::blind_store, "");
+  static_assert(mpl::auto_write_strategy< E0 >::value == write_strategy::reset_to, "");
+  static_assert(mpl::auto_write_strategy< B_lo >::value == write_strategy::rmw, "");
+
+  B::store(0xff00);
+  C::store(0x00);
+  unittest::regdump_flush();
+
+  reglist< B_lo, C0 >::apply< write_strategy::rmw >();
+  assert(unittest::regdump_count("::load()") == 2);
+  assert(B::reg_value == 0xffab);
+  assert(C::reg_value == 0x00);
+
+  reglist< B_lo, C0 >::apply< write_strategy::reset_to >();
+  assert(unittest::regdump_count("::load()") == 0);
+  assert(B::reg_value == 0x00ab);
+  assert(C::reg_value == 0xfe);
+
+  reglist< B_lo, C0, E0 >::apply< write_strategy::blind_store >();
+  assert(unittest::regdump_count("::load()") == 0);
+  assert(B::reg_value == 0x00ab);
+  assert(C::reg_value == 0x00);
+  assert(E::reg_value == 0x01);
+
+  B::store(0xff00);
+  E::store(0x00);
+  unittest::regdump_flush();
+  reglist< A_hi, A1_0, A0, A2, B_lo, E0 >::apply< write_strategy::automatic >();
+  assert(unittest::regdump_count("::load()") == 1);  /* B only */
+  assert(A::reg_value == 0x05);
+  assert(B::reg_value == 0xffab);
+  assert(E::reg_value == 0x81);
+
+  /* strict_apply() only resets untouched registers on reset_to */
+  C::store(0x00);
+  unittest::regdump_flush();
+  reglist< B_lo >::strict_apply< write_strategy::automatic, B, C >();
+  assert(unittest::regdump_count("::store()") == 1);
+  assert(C::reg_value == 0x00);
+
+  reglist< B_lo >::strict_apply< write_strategy::reset_to, B, C >();
+  assert(unittest::regdump_count("::store()") == 2);
+  assert(C::reg_value == 0xff);
+
+  /* report<>: startup budget and final values of apply<strategy>() */
+  using A_nib = regmask< A, 0x50, 0xf0 >;
+
+  using resources    = typelist< C0, A0, Dummy, D0, B_lo, A1, E0, A_nib >;
+  using resources_rw = typelist< C0, A0, Dummy, D0, B_lo, A1, A_nib >;  /* no write-only registers */
+
+  using report      = make_reglist< resources >::report<>;
+  using report_rmw  = make_reglist< resources_rw >::report< write_strategy::rmw >;
+  using report_auto = make_reglist< resources >::report< write_strategy::automatic >;
+
+  static_assert(report::numof_registers == 5, "");
+  static_assert(report::numof_stores    == 5, "");
+  static_assert(report::numof_loads     == 0, "");
+
+  static_assert(report::table[0].addr == D::addr, "");  /* see arch/reg_order.hpp */
+  static_assert(report::table[1].addr == A::addr, "");
+  static_assert(report::table[4].addr == E::addr, "");
+
+  static_assert(report::value(A::addr) == 0x53, "");
+  static_assert(report::value(B::addr) == 0x00ab, "");
+  static_assert(report::value(C::addr) == 0xfe, "");
+  static_assert(report::value(D::addr) == 0x01, "");
+  static_assert(report::value(E::addr) == 0x81, "");
+  static_assert(report::known_mask(B::addr) == 0xffff, "");
+  static_assert(!report::contains(0x10), "");
+
+  /* rmw: only the bits of the clear_mask are known */
+  static_assert(report_rmw::numof_registers == 4, "");
+  static_assert(report_rmw::value(A::addr) == 0x53, "");
+  static_assert(report_rmw::known_mask(A::addr) == 0xf3, "");
+  static_assert(report_rmw::known_mask(B::addr) == 0x00ff, "");
+
+  static_assert(make_reglist< Dummy >::report<>::numof_stores == 0, "");
+
+  unittest::scramble< A, B, C, E, D >();
+  make_reglist< resources >::reset_to();
+  unittest::assert_count(report::numof_loads, report::numof_stores);
+  for(std::size_t i = 0; i < report::size; i++) {
+    switch(report::table[i].addr) {
+    case A::addr: assert(A::reg_value == report::table[i].value); break;
+    case B::addr: assert(B::reg_value == report::table[i].value); break;
+    case C::addr: assert(C::reg_value == report::table[i].value); break;
+    case D::addr: assert(D::reg_value == report::table[i].value); break;
+    case E::addr: assert(E::reg_value == report::table[i].value); break;
+    default: assert(false);
+    }
+  }
+
+  unittest::scramble< A, B, C, E, D >();
+  make_reglist< resources_rw >::apply< write_strategy::rmw >();
+  unittest::assert_count(report_rmw::numof_loads, report_rmw::numof_stores);
+
+  unittest::scramble< A, B, C, E, D >();
+  make_reglist< resources >::apply< write_strategy::automatic >();
+  unittest::assert_count(report_auto::numof_loads, report_auto::numof_stores);
+
+  report::dump();
+  report_rmw::dump();
+  unittest::regdump_flush();
+
+#ifdef UNITTEST_MUST_FAIL
+#warning UNITTEST_MUST_FAIL: read access to a write-only register
+  reglist< E0 >::apply< write_strategy::rmw >();
+#endif
+
   return 0;
 }
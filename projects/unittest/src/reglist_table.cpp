@@ -0,0 +1,146 @@
+/*
+ * OpenMPTL - C++ Microprocessor Template Library
+ *
+ * Copyright (C) 2012-2017 Axel Burri <axel@tty0.ch>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/* reglist_emission::automatic emits a table for 3 or more registers */
+#define CONFIG_REGLIST_TABLE_THRESHOLD  3
+
+#include <register.hpp>
+#include <cassert>
+#include <iostream>
+#include "regdump.hpp"
+
+using namespace mptl;
+
+std::ostream & mptl::sim::regdump_ostream = unittest::regdump;
+
+using A = reg< uint8_t,  0x00, rw, 0 >;
+using B = reg< uint16_t, 0x04, rw, 0 >;
+using C = reg< uint8_t,  0x08, rw, 0xff >;
+using E = reg< uint8_t,  0x0c, wo, 0x80 >;
+using R = reg< uint8_t,  0x10, ro, 0 >;
+
+namespace mptl {
+  template<> struct address_map< 0x00 > { static constexpr const char * name_str = "TEST::A"; };
+  template<> struct address_map< 0x04 > { static constexpr const char * name_str = "TEST::B"; };
+  template<> struct address_map< 0x08 > { static constexpr const char * name_str = "TEST::C"; };
+  template<> struct address_map< 0x0c > { static constexpr const char * name_str = "TEST::E"; };
+  template<> struct address_map< 0x10 > { static constexpr const char * name_str = "TEST::R"; };
+}
+
+using A0 = regmask< A, 0x01, 0x01 >;
+using A1 = regmask< A, 0x02, 0x02 >;
+using B0 = regmask< B, 0x01, 0x01 >;
+using B_lo = regmask< B, 0x00ab, 0x00ff >;
+using C0 = regmask< C, 0x00, 0x01 >;
+using E0 = regmask< E, 0x01, 0x01 >;
+using R0 = regmask< R, 0x01, 0x01 >;
+
+using D  = reg< uint32_t, 0x40023830, rw, 0 >;  /* RCC::AHB1ENR (arch f4) */
+using D0 = regmask< D, 0x01, 0x01 >;
+
+/** Store garbage to all test registers */
+static void scramble(void)
+{
+  unittest::scramble< A, B, C, D, E >();
+}
+
+
+int main()
+{
+  std::cout << "*** main ***" << std::endl;
+
+  using list_small = reglist< A0, B0 >;
+  using list_large = reglist< C0, A0, D0, B_lo, A1, E0 >;
+
+  static_assert(list_small::table_emission< write_strategy::reset_to >() == false, "");
+  static_assert(list_large::table_emission< write_strategy::reset_to >() == true, "");
+  static_assert(list_large::table_emission< write_strategy::blind_store >() == true, "");
+  static_assert(list_large::table_emission< write_strategy::rmw >() == false, "");
+  static_assert(list_large::table_emission< write_strategy::automatic >() == false, "");
+  static_assert(list_large::table_emission< write_strategy::reset_to, reglist_emission::unrolled >() == false, "");
+  static_assert(list_small::table_emission< write_strategy::reset_to, reglist_emission::table >() == true, "");
+
+  /* table and unrolled emission write the same values, in same order */
+  scramble();
+  list_large::reset_to< reglist_emission::unrolled >();
+  assert(unittest::regdump_count("::load()") == 0);
+  const unsigned a = A::reg_value, b = B::reg_value, c = C::reg_value, d = D::reg_value, e = E::reg_value;
+  assert(a == 0x03);
+  assert(b == 0xab);
+  assert(c == 0xfe);
+  assert(d == 0x01);
+  assert(e == 0x81);
+
+  scramble();
+  list_large::reset_to();  /* automatic: table */
+  assert(A::reg_value == a);
+  assert(B::reg_value == b);
+  assert(C::reg_value == c);
+  assert(D::reg_value == d);
+  assert(E::reg_value == e);
+
+  scramble();
+  list_large::reset_to< reglist_emission::unrolled >();
+  unittest::assert_store_order({ "RCC::AHB1ENR", "TEST::A", "TEST::B", "TEST::C", "TEST::E" });
+  list_large::reset_to< reglist_emission::table >();
+  unittest::assert_store_order({ "RCC::AHB1ENR", "TEST::A", "TEST::B", "TEST::C", "TEST::E" });
+
+  /* blind_store */
+  scramble();
+  list_large::apply< write_strategy::blind_store, reglist_emission::table >();
+  assert(unittest::regdump_count("::load()") == 0);
+  assert(A::reg_value == 0x03);
+  assert(B::reg_value == 0xab);
+  assert(C::reg_value == 0x00);
+  assert(D::reg_value == 0x01);
+  assert(E::reg_value == 0x01);
+
+  /* strict_reset_to() resets the untouched registers from the table */
+  scramble();
+  reglist< A0, B0 >::strict_reset_to< A, B, C >();  /* 3 registers: table */
+  assert(A::reg_value == 0x01);
+  assert(B::reg_value == 0x01);
+  assert(C::reg_value == 0xff);
+
+  /* small lists are unrolled */
+  scramble();
+  list_small::reset_to();
+  unittest::assert_store_order({ "TEST::A", "TEST::B" });
+  assert(A::reg_value == 0x01);
+  assert(B::reg_value == 0x01);
+
+  /* rmw is never emitted as table */
+  scramble();
+  list_large::apply< write_strategy::automatic >();
+  assert(unittest::regdump_count("::load()") == 3);  /* A, B, C */
+
+#ifdef UNITTEST_MUST_FAIL
+#warning UNITTEST_MUST_FAIL: table emission requires write_strategy::reset_to or write_strategy::blind_store
+  list_large::apply< write_strategy::rmw, reglist_emission::table >();
+#endif
+
+#ifdef UNITTEST_MUST_FAIL
+#warning UNITTEST_MUST_FAIL: write access to a read-only register
+  reglist< A0, B0, R0 >::reset_to< reglist_emission::table >();
+#endif
+
+  return 0;
+}
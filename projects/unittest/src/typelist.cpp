@@ -80,6 +80,110 @@ using list = typelist <
   void
   >;
 
+
+
+/* sort, group_by, partition */
+
+template<int N, int K>
+struct keyed : typelist_element {
+  static constexpr int n = N;
+  static constexpr int key = K;
+};
+
+struct key_of {
+  template<typename T>
+  using key = std::integral_constant< int, T::key >;
+};
+
+struct filter_positive_key {
+  template<typename T>
+  using filter = std::integral_constant< bool, (T::key > 0) >;
+};
+
+struct reg_addr_key {
+  template<typename T>
+  using key = std::integral_constant< reg_addr_t, T::reg_type::addr >;
+};
+
+using keyed_list = typelist< keyed<0, 3>, keyed<1, -1>, keyed<2, 3>, keyed<3, 0>, keyed<4, -1> >;
+
+static_assert(std::is_same<
+              keyed_list::sort< key_of >,
+              typelist< keyed<1, -1>, keyed<4, -1>, keyed<3, 0>, keyed<0, 3>, keyed<2, 3> >
+              >::value, "sort<> failed");
+
+static_assert(std::is_same<
+              keyed_list::group_by< key_of >,
+              sane_typelist<
+                sane_typelist< keyed<1, -1>, keyed<4, -1> >,
+                sane_typelist< keyed<3, 0> >,
+                sane_typelist< keyed<0, 3>, keyed<2, 3> >
+                >
+              >::value, "group_by<> failed");
+
+static_assert(std::is_same<
+              keyed_list::partition< filter_positive_key >::first,
+              typelist< keyed<0, 3>, keyed<2, 3> >
+              >::value, "partition<>::first failed");
+
+static_assert(std::is_same<
+              keyed_list::partition< filter_positive_key >::second,
+              typelist< keyed<1, -1>, keyed<3, 0>, keyed<4, -1> >
+              >::value, "partition<>::second failed");
+
+static_assert(std::is_same< typelist<>::sort< key_of >, typelist<> >::value, "sort<> of empty list failed");
+static_assert(std::is_same< typelist<>::group_by< key_of >, typelist<> >::value, "group_by<> of empty list failed");
+
+static_assert(std::is_same<
+              typelist< test_c, test_b, test_a_0 >::sort< reg_addr_key >,
+              typelist< test_a_0, test_b, test_c >
+              >::value, "sort<> by register address failed");
+
+/* larger list (multiple merge levels): keys (I * 7) % 13 */
+template<typename S>
+struct make_keyed_list;
+template<std::size_t... I>
+struct make_keyed_list< mpl::index_sequence< I... > > {
+  using type = typelist< keyed< I, (I * 7) % 13 >... >;
+};
+using large_keyed_list = make_keyed_list< mpl::make_index_sequence< 100 > >::type;
+
+static int last_key;
+static int last_n;
+static int count;
+
+struct check_sorted {
+  template<typename T>
+  static void command(void) {
+    assert((T::key > last_key) || ((T::key == last_key) && (T::n > last_n)));  /* stable */
+    last_key = T::key;
+    last_n = T::n;
+    count++;
+  }
+};
+
+static int group_key;
+
+struct check_group_element {
+  template<typename T>
+  static void command(void) {
+    if(group_key < 0)
+      group_key = T::key;
+    assert(T::key == group_key);  /* one key per group */
+  }
+};
+
+struct check_group {
+  template<typename G>
+  static void command(void) {
+    assert(G::size > 0);
+    group_key = -1;
+    G::template for_each< check_group_element >();
+    last_n = -1;
+    G::template for_each< check_sorted >();
+  }
+};
+
 using uniq_fail_list    = typelist < list, uniq_c >;
 using bitmask_fail_list = typelist < anti_test_a_0, list >;
 
@@ -103,5 +207,17 @@ int main()
   assert(C::load() == 0x10);
   assert(D::load() == 0x55555555);
 
+  last_key = -1;
+  last_n = -1;
+  large_keyed_list::sort< key_of >::for_each< check_sorted >();
+  assert(count == 100);
+
+  using groups = large_keyed_list::group_by< key_of >;
+  static_assert(groups::size == 13, "group_by<> failed");
+  last_key = -1;
+  count = 0;
+  groups::for_each< check_group >();
+  assert(count == 100);
+
   return 0;
 }
@@ -39,7 +39,7 @@ using resource_fail_list = mptl::typelist < irq42, irq42 >;
 int main()
 {
 #ifdef UNITTEST_MUST_FAIL
-#warning UNITTEST_MUST_FAIL: list contains more than one element
+#warning UNITTEST_MUST_FAIL: list contains more than one irq_handler<> for the same irq number
   using vt_fail = vector_table<&stack_top, resource_fail_list, default_isr>;
   auto arm_vector_table_fail = vt_fail::value;
 #endif